@@ -0,0 +1,113 @@
+// Headless benchmark for the analysis thread.
+//
+// Throughput: a synthetic source runs as fast as the worker drains it, and
+// the hops analyzed per second are counted.
+//
+// Latency: a real-time source feeds the worker while a fake 60 fps render
+// loop stalls for STALL_MS every STALL_EVERY frames. Capture -> published
+// should not care about the stalls; only published -> presented should.
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+#include "audio/analysis_thread.hpp"
+#include "audio/synthetic_source.hpp"
+#include "core/latency_histogram.hpp"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int FFT_SIZE = 1024;
+    constexpr double THROUGHPUT_SECONDS = 2.0;
+    constexpr double LATENCY_SECONDS = 5.0;
+    constexpr double FRAME_RATE = 60.0;
+    constexpr int STALL_EVERY = 10;
+    constexpr int STALL_MS = 100;
+
+    AnalysisRequirements spectrumOnly()
+    {
+        AnalysisRequirements requirements;
+        requirements.products = ANALYSIS_SPECTRUM;
+        return requirements;
+    }
+
+    void measureThroughput()
+    {
+        SignalSpec spec;
+        spec.kind = SignalKind::White;
+        SyntheticSource source(spec, SourcePacing::AsFastAsPossible);
+        if (!source.init())
+            return;
+
+        AnalysisThread analysis(source, FFT_SIZE);
+        analysis.setRequirements(spectrumOnly());
+        analysis.start();
+
+        // Every hop is either delivered to a poll() or counted as dropped
+        uint64_t hops = 0;
+        const auto start = Clock::now();
+        double elapsed = 0.0;
+        while (elapsed < THROUGHPUT_SECONDS)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            analysis.poll();
+            hops += analysis.latest().hopSequences.size();
+            elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        }
+        analysis.stop();
+        source.stop();
+        hops += analysis.hopsDropped();
+
+        const double audioSeconds = (double)hops * (FFT_SIZE / 2) / spec.sampleRate;
+        std::printf("throughput: %.0f hops/s (N = %d, 50%% overlap), %.1fx realtime\n", hops / elapsed, FFT_SIZE,
+                    audioSeconds / elapsed);
+    }
+
+    void measureStalledLatency()
+    {
+        SignalSpec spec;
+        spec.kind = SignalKind::Sweep;
+        SyntheticSource source(spec, SourcePacing::Realtime);
+        if (!source.init())
+            return;
+
+        AnalysisThread analysis(source, FFT_SIZE);
+        analysis.setRequirements(spectrumOnly());
+        analysis.start();
+
+        PipelineLatency latency;
+        uint64_t hops = 0;
+        const auto frameTime = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / FRAME_RATE));
+        const auto end = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(LATENCY_SECONDS));
+        auto deadline = Clock::now();
+        for (int frame = 1; Clock::now() < end; ++frame)
+        {
+            deadline += frameTime;
+            std::this_thread::sleep_until(deadline);
+            if (frame % STALL_EVERY == 0)
+            {
+                // A window drag or event burst holding up the UI thread
+                std::this_thread::sleep_for(std::chrono::milliseconds(STALL_MS));
+                deadline = Clock::now();
+            }
+
+            analysis.poll();
+            hops += analysis.latest().hopSequences.size();
+            latency.record(analysis.latest(), Clock::now());
+        }
+        analysis.stop();
+        source.stop();
+
+        std::printf("latency with a %d ms render stall every %d frames (%llu hops delivered, %llu dropped):\n", STALL_MS,
+                    STALL_EVERY, (unsigned long long)hops, (unsigned long long)analysis.hopsDropped());
+        latency.report(std::cout);
+    }
+}
+
+int main()
+{
+    measureThroughput();
+    measureStalledLatency();
+    return 0;
+}
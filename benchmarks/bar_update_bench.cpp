@@ -0,0 +1,80 @@
+// BarVisualizer::update() cost versus bar count. "update" includes mapping a
+// 4096-point spectrum onto the bands; "state" feeds an empty frame, which
+// leaves only the per-bar smoothing, color and peak loops over the arrays.
+// A second table holds the bar count and grows the FFT instead: the band
+// mapping reads every covered bin, so that part scales with the bin count.
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "visualizer/bar_visualizer.hpp"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr double TARGET_SECONDS = 0.2; // Per measurement
+    constexpr int FFT_SIZE = 4096;
+    constexpr int SWEEP_BARS = 256;
+
+    // Microseconds per update()
+    double measure(BarVisualizer &bars, std::vector<AnalysisFrame> &frames)
+    {
+        size_t calls = 0;
+        const auto start = Clock::now();
+        double elapsed = 0.0;
+        while (elapsed < TARGET_SECONDS)
+        {
+            for (const AnalysisFrame &frame : frames)
+            {
+                bars.update(frame, 1.0f / 60.0f);
+                ++calls;
+            }
+            elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        }
+        return elapsed * 1e6 / calls;
+    }
+
+    // A few different spectra, so bars keep rising and falling
+    std::vector<AnalysisFrame> makeSpectra(int fftSize)
+    {
+        std::vector<AnalysisFrame> spectra(8);
+        for (size_t f = 0; f < spectra.size(); ++f)
+        {
+            spectra[f].products = ANALYSIS_SPECTRUM;
+            spectra[f].bins.resize(fftSize / 2 + 1);
+            for (size_t k = 0; k < spectra[f].bins.size(); ++k)
+                spectra[f].bins[k] = 0.5f + 0.45f * std::sin(0.013f * k + 0.8f * f);
+        }
+        return spectra;
+    }
+}
+
+int main()
+{
+    std::vector<AnalysisFrame> spectra = makeSpectra(FFT_SIZE);
+    std::vector<AnalysisFrame> empty(8);
+
+    std::printf("%-6s %12s %10s %12s %10s\n", "bars", "update us", "ns/bar", "state us", "ns/bar");
+    for (int barCount : {16, 64, 256, 1024, 4096, 8192})
+    {
+        BarVisualizer bars(barCount, 1920.0f, 1080.0f);
+        double update = measure(bars, spectra);
+        double state = measure(bars, empty);
+        std::printf("%-6d %12.2f %10.2f %12.2f %10.2f\n", barCount, update, update * 1e3 / barCount, state,
+                    state * 1e3 / barCount);
+    }
+
+    // Subtract "state" from either column for the mapping alone
+    std::printf("\n%-6s %-6s %10s %10s %10s\n", "bars", "N", "max us", "rms us", "state us");
+    for (int fftSize = 1024; fftSize <= 65536; fftSize *= 4)
+    {
+        std::vector<AnalysisFrame> sweep = makeSpectra(fftSize);
+        BarVisualizer bars(SWEEP_BARS, 1920.0f, 1080.0f);
+        double maxUs = measure(bars, sweep);
+        bars.setAggregate(BandAggregate::Rms);
+        double rmsUs = measure(bars, sweep);
+        double state = measure(bars, empty);
+        std::printf("%-6d %-6d %10.2f %10.2f %10.2f\n", SWEEP_BARS, fftSize, maxUs, rmsUs, state);
+    }
+    return 0;
+}
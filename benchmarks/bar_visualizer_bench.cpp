@@ -0,0 +1,112 @@
+// BarVisualizer frame cost at 64, 512 and 4096 bars: draw calls and vertices
+// submitted per frame, and the CPU time of update() + draw() on its own
+// (what the render thread pays before the GPU sees anything) and when
+// rasterized by the software backend at 1920x1080.
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "render/software_surface.hpp"
+#include "visualizer/bar_visualizer.hpp"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr double TARGET_SECONDS = 0.5; // Per measurement
+    constexpr unsigned int WIDTH = 1920;
+    constexpr unsigned int HEIGHT = 1080;
+    constexpr int FFT_SIZE = 4096;
+
+    // Counts what reaches the surface and optionally forwards it
+    class CountingSurface : public RenderSurface
+    {
+    public:
+        explicit CountingSurface(RenderSurface *target) : m_target(target) {}
+
+        sf::Vector2u size() const override { return {WIDTH, HEIGHT}; }
+        void clear(sf::Color color) override
+        {
+            if (m_target)
+                m_target->clear(color);
+        }
+        void drawVertices(const sf::Vertex *vertices, std::size_t count, sf::PrimitiveType type) override
+        {
+            drawCalls++;
+            vertexCount += count;
+            if (m_target)
+                m_target->drawVertices(vertices, count, type);
+        }
+        std::unique_ptr<SurfaceImage> createImage(sf::Vector2u size) override
+        {
+            return m_target ? m_target->createImage(size) : nullptr;
+        }
+        void drawImage(const SurfaceImage &image, sf::FloatRect dest, float scrollX) override
+        {
+            drawCalls++;
+            if (m_target)
+                m_target->drawImage(image, dest, scrollX);
+        }
+
+        std::size_t drawCalls = 0;
+        std::size_t vertexCount = 0;
+
+    private:
+        RenderSurface *m_target;
+    };
+
+    // A moving spectrum, so bars rise and fall like they would on music
+    void fillSpectrum(AnalysisFrame &frame, int index)
+    {
+        for (size_t k = 0; k < frame.bins.size(); ++k)
+            frame.bins[k] = 0.5f + 0.45f * std::sin(0.013f * k + 0.21f * index) * std::cos(0.002f * k * (index % 7));
+    }
+
+    struct FrameCost
+    {
+        double microseconds = 0.0;
+        double drawCalls = 0.0;
+        double vertices = 0.0;
+    };
+
+    FrameCost measure(int barCount, RenderSurface *raster)
+    {
+        BarVisualizer bars(barCount, (float)WIDTH, (float)HEIGHT);
+        AnalysisFrame frame;
+        frame.products = ANALYSIS_SPECTRUM;
+        frame.bins.resize(FFT_SIZE / 2 + 1);
+        CountingSurface surface(raster);
+
+        int frames = 0;
+        double elapsed = 0.0;
+        while (elapsed < TARGET_SECONDS)
+        {
+            fillSpectrum(frame, frames); // Not timed
+            const auto start = Clock::now();
+            surface.clear(sf::Color::Black);
+            bars.update(frame, 1.0f / 60.0f);
+            bars.draw(surface);
+            elapsed += std::chrono::duration<double>(Clock::now() - start).count();
+            frames++;
+        }
+
+        FrameCost cost;
+        cost.microseconds = elapsed * 1e6 / frames;
+        cost.drawCalls = (double)surface.drawCalls / frames;
+        cost.vertices = (double)surface.vertexCount / frames;
+        return cost;
+    }
+}
+
+int main()
+{
+    SoftwareSurface software(WIDTH, HEIGHT);
+    std::printf("%-6s %10s %10s %12s %14s\n", "bars", "draws", "vertices", "cpu us", "software us");
+    for (int barCount : {64, 512, 4096})
+    {
+        FrameCost cpu = measure(barCount, nullptr);
+        FrameCost rasterized = measure(barCount, &software);
+        std::printf("%-6d %10.0f %10.0f %12.2f %14.2f\n", barCount, cpu.drawCalls, cpu.vertices, cpu.microseconds,
+                    rasterized.microseconds);
+    }
+    return 0;
+}
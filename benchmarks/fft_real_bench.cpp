@@ -0,0 +1,66 @@
+// Real-input kiss_fftr against the complex kiss_fft path FftProcessor used
+// before (real samples, imaginary part zeroed), at N = 512 .. 65536.
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "kissfft/kiss_fft.h"
+#include "kissfft/kiss_fftr.h"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr double TARGET_SECONDS = 0.2; // Per measurement
+
+    // Microseconds per transform
+    template <typename Fn>
+    double measure(Fn fn)
+    {
+        size_t calls = 0;
+        const auto start = Clock::now();
+        double elapsed = 0.0;
+        while (elapsed < TARGET_SECONDS)
+        {
+            for (int i = 0; i < 8; ++i, ++calls)
+                fn();
+            elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        }
+        return elapsed * 1e6 / calls;
+    }
+}
+
+int main()
+{
+    volatile float sink = 0.0f;
+    std::printf("%-8s %12s %12s %8s\n", "N", "complex us", "real us", "speedup");
+    for (int n = 512; n <= 65536; n *= 2)
+    {
+        std::vector<float> samples(n);
+        for (int i = 0; i < n; ++i)
+            samples[i] = std::sin(0.37f * i) * 0.5f + std::sin(0.011f * i) * 0.25f;
+
+        kiss_fft_cfg complexCfg = kiss_fft_alloc(n, 0, NULL, NULL);
+        std::vector<kiss_fft_cpx> complexIn(n), complexOut(n);
+        double complexUs = measure(
+            [&]
+            {
+                for (int i = 0; i < n; ++i)
+                {
+                    complexIn[i].r = samples[i];
+                    complexIn[i].i = 0.0f;
+                }
+                kiss_fft(complexCfg, complexIn.data(), complexOut.data());
+            });
+        sink = sink + complexOut[n / 4].r;
+        kiss_fft_free(complexCfg);
+
+        kiss_fftr_cfg realCfg = kiss_fftr_alloc(n, 0, NULL, NULL);
+        std::vector<kiss_fft_cpx> realOut(n / 2 + 1);
+        double realUs = measure([&] { kiss_fftr(realCfg, samples.data(), realOut.data()); });
+        sink = sink + realOut[n / 4].r;
+        kiss_fftr_free(realCfg);
+
+        std::printf("%-8d %12.2f %12.2f %7.2fx\n", n, complexUs, realUs, complexUs / realUs);
+    }
+    return 0;
+}
@@ -0,0 +1,67 @@
+// Microbenchmark for magnitudeToDb(): every implementation this CPU can run
+// against the original per-bin sqrt / log10 / divide loop, at the bin counts
+// of 1024-, 8192- and 65536-point FFTs.
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "audio/spectrum_kernels.hpp"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr double TARGET_SECONDS = 0.2; // Per measurement
+
+    void originalLoop(const kiss_fft_cpx *bins, size_t count, float scale, float *out)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            float magnitude = std::sqrt(bins[i].r * bins[i].r + bins[i].i * bins[i].i);
+            out[i] = 20.0f * std::log10(magnitude + 1.0f) * scale;
+        }
+    }
+
+    // Nanoseconds per bin
+    template <typename Fn>
+    double measure(Fn fn, const std::vector<kiss_fft_cpx> &bins, std::vector<float> &out)
+    {
+        size_t calls = 0;
+        const auto start = Clock::now();
+        double elapsed = 0.0;
+        while (elapsed < TARGET_SECONDS)
+        {
+            for (int i = 0; i < 16; ++i, ++calls)
+                fn(bins.data(), bins.size(), 1.0f / 60.0f, out.data());
+            elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        }
+        return elapsed * 1e9 / ((double)calls * bins.size());
+    }
+}
+
+int main()
+{
+    volatile float sink = 0.0f;
+    std::printf("%-8s %-8s %10s %8s\n", "bins", "kernel", "ns/bin", "speedup");
+    for (size_t count : {513, 4097, 32769})
+    {
+        std::vector<kiss_fft_cpx> bins(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            bins[i].r = std::sin(0.37f * i) * 40.0f;
+            bins[i].i = std::cos(0.11f * i) * 25.0f;
+        }
+        std::vector<float> out(count);
+
+        double baseline = measure(originalLoop, bins, out);
+        sink = sink + out[count / 2];
+        std::printf("%-8zu %-8s %10.3f %7.1fx\n", count, "original", baseline, 1.0);
+
+        for (const MagnitudeToDbKernel &kernel : magnitudeToDbKernels())
+        {
+            double ns = measure(kernel.fn, bins, out);
+            sink = sink + out[count / 2];
+            std::printf("%-8zu %-8s %10.3f %7.1fx\n", count, kernel.name, ns, baseline / ns);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// Analysis products a visualizer can ask for. The analysis thread only
+// computes what the active visualizer declares it needs.
+enum AnalysisProduct : unsigned int
+{
+    ANALYSIS_SPECTRUM = 1u << 0, // STFT magnitudes (AnalysisFrame::bins, hopSpectra)
+    ANALYSIS_WAVEFORM = 1u << 1, // Min/max envelope of recent audio (waveMin / waveMax)
+    ANALYSIS_STEREO = 1u << 2,   // Raw left/right sample pairs (stereoLeft / stereoRight)
+};
+
+struct AnalysisRequirements
+{
+    unsigned int products = ANALYSIS_SPECTRUM; // AnalysisProduct flags
+
+    // ANALYSIS_WAVEFORM: how much audio to cover and in how many columns
+    unsigned int waveformColumns = 0;
+    float waveformSeconds = 0.0f;
+    bool waveformTrigger = false; // Start the span on a rising zero crossing
+
+    // ANALYSIS_STEREO: how many of the latest sample pairs to attach to each
+    // frame; should cover the longest gap between two frames the renderer sees
+    unsigned int stereoMaxPairs = 0;
+};
+
+// One completed analysis result, handed from the analysis thread to the renderer
+struct AnalysisFrame
+{
+    unsigned int products = 0; // Which of the products below are filled in
+
+    // Normalized magnitudes, N/2 + 1 bins: the per-bin maximum over the hops
+    // below, so short transients between two frames aren't lost
+    std::vector<float> bins;
+
+    // Every STFT hop since the previous frame, oldest first: one row of
+    // bins.size() values per entry of hopSequences, which holds the sample
+    // sequence at the end of that hop's window
+    std::vector<float> hopSpectra;
+    std::vector<uint64_t> hopSequences;
+
+    // Per-column sample range over the requested span, oldest column first
+    std::vector<float> waveMin;
+    std::vector<float> waveMax;
+    bool waveTriggered = false; // Span starts on a trigger point
+
+    // The latest left/right pairs ending at `sequence` (newest last, at most
+    // stereoMaxPairs). Consecutive frames overlap; draw only the pairs past
+    // the previous frame's sequence. Mono devices repeat the one channel.
+    std::vector<float> stereoLeft;
+    std::vector<float> stereoRight;
+
+    uint64_t sequence = 0; // Source sample sequence at the end of the analyzed audio
+    double time = 0.0;     // Same point in audio time, in seconds since the source started
+    std::chrono::steady_clock::time_point capturedAt;  // When the newest analyzed sample arrived
+    std::chrono::steady_clock::time_point publishedAt;
+};
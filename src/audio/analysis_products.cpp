@@ -0,0 +1,93 @@
+#include "analysis_products.hpp"
+#include <algorithm>
+#include "wave_trigger.hpp"
+#include "waveform_decimator.hpp"
+
+namespace
+{
+    // Trigger search: at most this far back (or one span, if shorter), which
+    // keeps the per-frame cost bounded and covers periods down to ~5 Hz
+    constexpr size_t TRIGGER_MAX_SEARCH = 8192;
+    constexpr float TRIGGER_HYSTERESIS = 0.02f;
+}
+
+void foldHops(AnalysisFrame &frame)
+{
+    const size_t hops = frame.hopSequences.size();
+    if (hops == 0)
+        return;
+
+    const size_t binCount = frame.hopSpectra.size() / hops;
+    frame.bins.assign(frame.hopSpectra.begin(), frame.hopSpectra.begin() + binCount);
+    float *bins = frame.bins.data();
+    for (size_t h = 1; h < hops; ++h)
+    {
+        const float *row = frame.hopSpectra.data() + h * binCount;
+        for (size_t i = 0; i < binCount; ++i)
+            bins[i] = std::max(bins[i], row[i]);
+    }
+}
+
+void fillWaveform(const AudioHistory &history, unsigned int sampleRate,
+                  const AnalysisRequirements &requirements, AnalysisFrame &frame)
+{
+    size_t columns = requirements.waveformColumns;
+    size_t span = (size_t)(std::max(requirements.waveformSeconds, 0.0f) * sampleRate);
+    span = std::min(span, history.capacity());
+
+    size_t search = 0;
+    if (requirements.waveformTrigger)
+        search = std::min({span, TRIGGER_MAX_SEARCH, history.capacity() - span});
+
+    // Line the envelope up with the spectrum when there is one. With the
+    // trigger on, also fetch `search` older samples to look for a start point.
+    AudioSnapshot audio = history.ending(frame.sequence, span + search);
+    if (audio.size() != span + search)
+        audio = history.latest(span + search);
+
+    // Latest rising edge that still leaves a full span after it; without one
+    // the span simply ends at the newest sample
+    const float *start = audio.data + search;
+    frame.waveTriggered = false;
+    if (search > 0)
+    {
+        long edge = findLastRisingEdge(audio.data, search + 1, TRIGGER_HYSTERESIS);
+        if (edge >= 0)
+        {
+            start = audio.data + edge;
+            frame.waveTriggered = true;
+        }
+    }
+
+    frame.waveMin.resize(columns);
+    frame.waveMax.resize(columns);
+    decimateMinMax(start, audio.size() - search, columns, frame.waveMin.data(), frame.waveMax.data());
+}
+
+void fillStereo(const AudioHistory *left, const AudioHistory *right, size_t count, AnalysisFrame &frame)
+{
+    if (right == nullptr)
+        right = left;
+    if (left == nullptr)
+        count = 0;
+    else
+        count = std::min({count, left->capacity(), right->capacity()});
+
+    frame.stereoLeft.resize(count);
+    frame.stereoRight.resize(count);
+    if (count == 0)
+        return;
+
+    // The channel histories advance in step with the downmix, so the same
+    // window end lines the pairs up with the other products
+    AudioSnapshot l = left->ending(frame.sequence, count);
+    AudioSnapshot r = right->ending(frame.sequence, count);
+    if (l.size() != count || r.size() != count)
+    {
+        l = left->latest(count);
+        r = right->latest(count);
+    }
+
+    std::copy(l.data, l.data + count, frame.stereoLeft.begin());
+    std::copy(r.data, r.data + count, frame.stereoRight.begin());
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <cstddef>
+#include "analysis_frame.hpp"
+#include "audio_history.hpp"
+
+// Builders for the non-FFT analysis products, shared by the live analysis
+// thread and offline rendering. Both read audio ending at frame.sequence.
+
+// ANALYSIS_SPECTRUM: sets bins to the per-bin maximum over the frame's hops
+// (hopSpectra), so a transient in any hop since the previous frame still
+// shows. Leaves bins alone when the frame carries no hops.
+void foldHops(AnalysisFrame &frame);
+
+// ANALYSIS_WAVEFORM: per-column min/max over the requested span (optionally
+// starting on a trigger point). Fills waveMin, waveMax and waveTriggered.
+void fillWaveform(const AudioHistory &history, unsigned int sampleRate,
+                  const AnalysisRequirements &requirements, AnalysisFrame &frame);
+
+// ANALYSIS_STEREO: the `count` left/right pairs ending at frame.sequence.
+// A null `right` (mono source) repeats the left channel; a null `left`
+// yields no pairs.
+void fillStereo(const AudioHistory *left, const AudioHistory *right, size_t count, AnalysisFrame &frame);
@@ -0,0 +1,160 @@
+#include "analysis_thread.hpp"
+#include <algorithm>
+#include "analysis_products.hpp"
+
+namespace
+{
+    // How long to back off when no new audio has arrived. Well under one
+    // device period, so new samples are picked up promptly.
+    constexpr auto IDLE_WAIT = std::chrono::milliseconds(2);
+
+    // Hops the queue holds for a stalled renderer: ~0.75 s at the default
+    // 1024-sample FFT with 50% overlap
+    constexpr size_t HOP_QUEUE = 64;
+}
+
+AnalysisThread::AnalysisThread(AudioSource &source, int fftSize, float overlap)
+    : m_source(source), m_fft(fftSize), m_hopSpectra(HOP_QUEUE * (size_t)(m_fft.size() / 2 + 1)),
+      m_hopEnds(HOP_QUEUE)
+{
+    overlap = std::clamp(overlap, 0.0f, 0.95f);
+    m_fft.setHopSize((int)(m_fft.size() * (1.0f - overlap)));
+}
+
+AnalysisThread::~AnalysisThread()
+{
+    stop();
+}
+
+void AnalysisThread::start()
+{
+    if (m_running.exchange(true))
+        return;
+    m_worker = std::thread(&AnalysisThread::run, this);
+}
+
+void AnalysisThread::stop()
+{
+    m_running = false;
+    if (m_worker.joinable())
+        m_worker.join();
+}
+
+void AnalysisThread::setRequirements(const AnalysisRequirements &requirements)
+{
+    m_waveColumns.store(requirements.waveformColumns, std::memory_order_relaxed);
+    m_waveSeconds.store(requirements.waveformSeconds, std::memory_order_relaxed);
+    m_waveTrigger.store(requirements.waveformTrigger, std::memory_order_relaxed);
+    m_stereoPairs.store(requirements.stereoMaxPairs, std::memory_order_relaxed);
+    m_products.store(requirements.products, std::memory_order_relaxed);
+}
+
+bool AnalysisThread::poll()
+{
+    const bool changed = m_frames.update();
+
+    // Hops go to the slot we own, so the worker never sees these fields
+    AnalysisFrame &frame = m_frames.readBuffer();
+    frame.hopSpectra.clear();
+    frame.hopSequences.clear();
+
+    const size_t binCount = (size_t)(m_fft.size() / 2 + 1);
+    uint64_t endSequence;
+    while (m_hopEnds.pop(&endSequence, 1) == 1)
+    {
+        // The row was pushed before its end, so it's complete
+        size_t offset = frame.hopSpectra.size();
+        frame.hopSpectra.resize(offset + binCount);
+        m_hopSpectra.pop(frame.hopSpectra.data() + offset, binCount);
+        frame.hopSequences.push_back(endSequence);
+    }
+
+    // A transient in a hop that was never the newest still reaches the bars
+    foldHops(frame);
+    return changed;
+}
+
+void AnalysisThread::queueHop(const std::vector<float> &bins, uint64_t endSequence)
+{
+    // A hop goes in whole or not at all, so the two rings never fall out of step
+    if (m_hopSpectra.writable() < bins.size() || m_hopEnds.writable() == 0)
+    {
+        m_hopsDropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    m_hopSpectra.push(bins.data(), bins.size());
+    m_hopEnds.push(&endSequence, 1);
+}
+
+void AnalysisThread::publishFrame(const AudioHistory &history, unsigned int products)
+{
+    AnalysisFrame &frame = m_frames.writeBuffer();
+    frame.products = products;
+    frame.time = frame.sequence / (double)m_source.sampleRate();
+
+    if (products & ANALYSIS_WAVEFORM)
+    {
+        AnalysisRequirements requirements;
+        requirements.waveformColumns = m_waveColumns.load(std::memory_order_relaxed);
+        requirements.waveformSeconds = m_waveSeconds.load(std::memory_order_relaxed);
+        requirements.waveformTrigger = m_waveTrigger.load(std::memory_order_relaxed);
+        fillWaveform(history, m_source.sampleRate(), requirements, frame);
+    }
+
+    if (products & ANALYSIS_STEREO)
+    {
+        // The newest stereoMaxPairs pairs ending at frame.sequence. Frames the
+        // renderer skips overlap the next one, which then still holds their
+        // pairs; the visualizer uses sequence to draw each pair once.
+        fillStereo(m_source.channel(0), m_source.channel(1), m_stereoPairs.load(std::memory_order_relaxed), frame);
+    }
+
+    frame.capturedAt = m_source.capturedAt(frame.sequence);
+    frame.publishedAt = std::chrono::steady_clock::now();
+    m_lastSequence = frame.sequence;
+    m_frames.publish();
+    m_published.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AnalysisThread::run()
+{
+    while (m_running.load(std::memory_order_relaxed))
+    {
+        const AudioHistory &history = m_source.drainHistory();
+        const unsigned int products = m_products.load(std::memory_order_relaxed);
+
+        bool fresh;
+        if (products & ANALYSIS_SPECTRUM)
+        {
+            // Every hop is analyzed and queued for the renderer, which folds
+            // them into bins on poll(). The frame published below carries the
+            // newest one, for a poll that finds the queue already empty.
+            size_t hops = m_fft.processHops(history, [&](const std::vector<float> &bins, uint64_t endSequence)
+            {
+                queueHop(bins, endSequence);
+                AnalysisFrame &frame = m_frames.writeBuffer();
+                frame.bins = bins;
+                frame.sequence = endSequence;
+            });
+            fresh = hops > 0;
+        }
+        else
+        {
+            // No FFT needed: keep the hop schedule current so re-enabling the
+            // spectrum doesn't replay a backlog, and publish on new audio only
+            m_fft.restartHops(history.sequence());
+            fresh = history.sequence() != m_lastSequence;
+            if (fresh)
+            {
+                AnalysisFrame &frame = m_frames.writeBuffer();
+                frame.bins.clear();
+                frame.sequence = history.sequence();
+            }
+        }
+
+        if (fresh)
+            publishFrame(history, products);
+        else
+            std::this_thread::sleep_for(IDLE_WAIT);
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <atomic>
+#include <thread>
+#include "audio_source.hpp"
+#include "fft_processor.hpp"
+#include "analysis_frame.hpp"
+#include "core/triple_buffer.hpp"
+
+// Runs capture draining and the FFT on a worker thread so the render loop
+// never waits on analysis (and vice versa). The stream is analyzed as an STFT,
+// one spectrum per hop of audio. The newest result is published through a
+// triple buffer, so the renderer only ever picks up the latest frame, while
+// every hop's spectrum also goes through a lock-free queue and arrives with
+// the next poll(). Only the products named in setRequirements() are computed.
+//
+// Once started, this thread is the sole consumer of the AudioSource.
+class AnalysisThread
+{
+public:
+    // overlap: fraction of each window shared with the next (0.5 = hop of N/2)
+    AnalysisThread(AudioSource &source, int fftSize = 1024, float overlap = 0.5f);
+    ~AnalysisThread();
+
+    void start();
+    void stop();
+
+    // Render side: swaps in the newest published frame, if any, and attaches
+    // the hops queued since the previous poll (AnalysisFrame::hopSpectra).
+    // Returns true when latest() changed.
+    bool poll();
+    const AnalysisFrame &latest() const { return m_frames.readBuffer(); }
+
+    // Declares what the active visualizer needs. Safe to call while running;
+    // takes effect on the worker's next pass.
+    void setRequirements(const AnalysisRequirements &requirements);
+
+    uint64_t framesPublished() const { return m_published.load(std::memory_order_relaxed); }
+
+    // Hops the renderer never picked up because it stalled and the queue was full
+    uint64_t hopsDropped() const { return m_hopsDropped.load(std::memory_order_relaxed); }
+
+private:
+    AudioSource &m_source;
+    FftProcessor m_fft;
+    TripleBuffer<AnalysisFrame> m_frames;
+    SpscRingBuffer<float> m_hopSpectra; // Worker -> renderer, one row of bins per hop
+    SpscRingBuffer<uint64_t> m_hopEnds; // Window end of each queued row
+    std::atomic<uint64_t> m_hopsDropped{0};
+    std::atomic<unsigned int> m_products{ANALYSIS_SPECTRUM};
+    std::atomic<unsigned int> m_waveColumns{0};
+    std::atomic<float> m_waveSeconds{0.0f};
+    std::atomic<bool> m_waveTrigger{false};
+    std::atomic<unsigned int> m_stereoPairs{0};
+    uint64_t m_lastSequence = 0; // Worker only
+
+    std::thread m_worker;
+    std::atomic<bool> m_running{false};
+    std::atomic<uint64_t> m_published{0};
+
+    void run();
+    void publishFrame(const AudioHistory &history, unsigned int products);
+    void queueHop(const std::vector<float> &bins, uint64_t endSequence);
+};
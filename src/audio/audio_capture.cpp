@@ -1,15 +1,22 @@
 #include "audio_capture.hpp"
 #include <iostream>
 
-AudioCapture::AudioCapture()
+namespace
+{
+    constexpr ma_uint32 SAMPLE_RATE = 44100;
+}
+
+AudioCapture::AudioCapture(float historySeconds)
+    : AudioSource(historySeconds)
 {
-    audioBuffer.resize(1024, 0.0f);
 }
 
 AudioCapture::~AudioCapture()
 {
-    ma_device_uninit(&device);
-    ma_context_uninit(&context);
+    if (deviceReady)
+        ma_device_uninit(&device);
+    if (contextReady)
+        ma_context_uninit(&context);
 }
 
 void AudioCapture::data_callback(ma_device *pDevice, void *pOutput, const void *pInput, ma_uint32 frameCount)
@@ -18,40 +25,37 @@ void AudioCapture::data_callback(ma_device *pDevice, void *pOutput, const void *
         return;
 
     AudioCapture *self = (AudioCapture *)pDevice->pUserData;
-    const float *inputData = (const float *)pInput;
-
-    // Lock memory while writing
-    std::lock_guard<std::mutex> lock(self->bufferMutex);
-
-    // Copy left channel only (stereo to mono)
-    for (size_t i = 0; i < frameCount && i < self->audioBuffer.size(); i++)
-    {
-        self->audioBuffer[i] = inputData[i * 2];
-    }
+    self->pushInterleaved((const float *)pInput, frameCount, pDevice->capture.channels);
 }
 
 bool AudioCapture::init()
 {
     if (ma_context_init(NULL, 0, NULL, &context) != MA_SUCCESS)
         return false;
+    contextReady = true;
 
     ma_device_config config = ma_device_config_init(ma_device_type_loopback);
     config.capture.format = ma_format_f32;
-    config.capture.channels = 2;
-    config.sampleRate = 44100;
+    config.capture.channels = 0; // Device native channel count
+    config.sampleRate = SAMPLE_RATE;
     config.dataCallback = data_callback;
     config.pUserData = this;
 
     if (ma_device_init(&context, &config, &device) != MA_SUCCESS)
         return false;
+    deviceReady = true;
+
+    // Allocate the planar streams before the callback can run
+    configureStream(SAMPLE_RATE, device.capture.channels);
+    std::cout << "[INFO] Capturing " << device.capture.channels << " channel(s)." << std::endl;
+
     if (ma_device_start(&device) != MA_SUCCESS)
         return false;
 
     return true;
 }
 
-std::vector<float> AudioCapture::getAudioBuffer()
+unsigned int AudioCapture::sampleRate() const
 {
-    std::lock_guard<std::mutex> lock(bufferMutex);
-    return audioBuffer;
-}
\ No newline at end of file
+    return SAMPLE_RATE;
+}
@@ -1,22 +1,22 @@
 #pragma once
-#include <vector>
-#include <mutex>
 #include "miniaudio.h"
+#include "audio_source.hpp"
 
-class AudioCapture
+// System output loopback: analyzes whatever is currently playing
+class AudioCapture : public AudioSource
 {
 public:
-    AudioCapture();
-    ~AudioCapture();
+    explicit AudioCapture(float historySeconds = 4.0f);
+    ~AudioCapture() override;
 
-    bool init();
-    std::vector<float> getAudioBuffer(); // Returns a safe copy of data
+    bool init() override;
+    unsigned int sampleRate() const override;
 
 private:
     ma_device device;
     ma_context context;
-    std::vector<float> audioBuffer;
-    std::mutex bufferMutex; // Prevents crashing when reading/writing at same time
+    bool deviceReady = false;
+    bool contextReady = false;
 
     static void data_callback(ma_device *pDevice, void *pOutput, const void *pInput, ma_uint32 frameCount);
-};
\ No newline at end of file
+};
@@ -0,0 +1,79 @@
+#include "audio_history.hpp"
+#include <algorithm>
+#include <cstring>
+
+AudioHistory::AudioHistory(size_t capacity) : m_capacity(std::max<size_t>(capacity, 1))
+{
+    m_data.resize(m_capacity * 2, 0.0f);
+}
+
+void AudioHistory::commit(size_t count)
+{
+    // Keep both halves identical for the span we just wrote
+    std::memcpy(m_data.data() + m_capacity + m_write, m_data.data() + m_write, count * sizeof(float));
+    m_write = (m_write + count) % m_capacity;
+    m_sequence += count;
+}
+
+void AudioHistory::append(const float *samples, size_t count)
+{
+    // Only the newest `capacity` samples can survive anyway
+    if (count > m_capacity)
+    {
+        m_sequence += count - m_capacity;
+        samples += count - m_capacity;
+        count = m_capacity;
+    }
+
+    while (count > 0)
+    {
+        size_t run = std::min(count, m_capacity - m_write);
+        std::memcpy(m_data.data() + m_write, samples, run * sizeof(float));
+        commit(run);
+        samples += run;
+        count -= run;
+    }
+}
+
+size_t AudioHistory::drain(SpscRingBuffer<float> &ring, size_t maxCount)
+{
+    // Pop straight into the primary half, one contiguous run at a time
+    size_t total = 0;
+    size_t popped;
+    while (total < maxCount &&
+           (popped = ring.pop(m_data.data() + m_write, std::min(m_capacity - m_write, maxCount - total))) > 0)
+    {
+        commit(popped);
+        total += popped;
+    }
+    return total;
+}
+
+AudioSnapshot AudioHistory::latest(size_t count) const
+{
+    count = std::min(count, m_capacity);
+
+    // The window ending at m_write starts at m_write + capacity - count, which
+    // never runs past the mirrored half
+    AudioSnapshot view;
+    view.data = m_data.data() + m_write + m_capacity - count;
+    view.count = count;
+    view.sequence = m_sequence;
+    return view;
+}
+
+AudioSnapshot AudioHistory::ending(uint64_t endSequence, size_t count) const
+{
+    if (endSequence > m_sequence || endSequence < count)
+        return AudioSnapshot();
+
+    uint64_t age = m_sequence - endSequence;
+    if (age + count > m_capacity)
+        return AudioSnapshot();
+
+    AudioSnapshot view;
+    view.data = m_data.data() + m_write + m_capacity - age - count;
+    view.count = count;
+    view.sequence = endSequence;
+    return view;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "audio_snapshot.hpp"
+#include "spsc_ring_buffer.hpp"
+
+// Rolling history of the most recent samples of a single stream.
+//
+// Every sample is stored twice, at i and i + capacity, so any window of up to
+// `capacity` samples ending at the write head is one contiguous span. That lets
+// the FFT (of any size up to the history length) and overlapped analysis read
+// straight from here without stitching wrap-around segments together.
+class AudioHistory
+{
+public:
+    explicit AudioHistory(size_t capacity);
+
+    size_t capacity() const { return m_capacity; }
+    uint64_t sequence() const { return m_sequence; }
+
+    // Appends samples, discarding the oldest ones once the history is full
+    void append(const float *samples, size_t count);
+
+    // Moves what is currently queued in the ring into the history, at most
+    // `maxCount` samples. Returns the number of samples drained.
+    size_t drain(SpscRingBuffer<float> &ring, size_t maxCount = SIZE_MAX);
+
+    // Newest `count` samples (clamped to capacity)
+    AudioSnapshot latest(size_t count) const;
+
+    // The `count` samples ending at sample sequence `endSequence`. Returns an
+    // empty view if that window is not (or no longer) fully in the history.
+    AudioSnapshot ending(uint64_t endSequence, size_t count) const;
+
+private:
+    std::vector<float> m_data; // 2 * capacity, second half mirrors the first
+    size_t m_capacity;
+    size_t m_write = 0;
+    uint64_t m_sequence = 0;
+
+    void commit(size_t count); // Mirrors freshly written [m_write, m_write + count)
+};
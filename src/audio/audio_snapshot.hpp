@@ -0,0 +1,15 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Read-only, contiguous view of captured samples, oldest first.
+// Valid until the owning history is next written to.
+struct AudioSnapshot
+{
+    const float *data = nullptr;
+    size_t count = 0;
+    uint64_t sequence = 0; // Total samples captured up to the end of this view
+
+    size_t size() const { return count; }
+    float operator[](size_t i) const { return data[i]; }
+};
@@ -0,0 +1,159 @@
+#include "audio_source.hpp"
+#include <algorithm>
+#include <thread>
+
+namespace
+{
+    constexpr size_t RING_CAPACITY = 65536; // ~1.5 s at 44.1 kHz of slack for a stalled consumer
+    constexpr size_t PUSH_CHUNK = 256;      // Stack staging size on the producer thread
+    constexpr size_t STAMP_CAPACITY = 1024; // Pushed blocks in flight, a few seconds' worth
+    constexpr size_t STAMP_HISTORY = 512;   // Blocks the consumer can still look up
+
+    // How long a producer backs off while the consumer has no room
+    constexpr auto FULL_WAIT = std::chrono::milliseconds(1);
+}
+
+AudioSource::AudioSource(float historySeconds)
+    : historySeconds(historySeconds), ring(RING_CAPACITY), history(1), stampRing(STAMP_CAPACITY),
+      stamps(STAMP_HISTORY, CaptureStamp{0, {}})
+{
+}
+
+void AudioSource::configureStream(unsigned int sampleRate, size_t channels, size_t extraSamples)
+{
+    size_t historySize = std::max<size_t>(1, (size_t)(historySeconds * sampleRate) + extraSamples);
+    history = AudioHistory(historySize);
+
+    channels = std::min(channels, MAX_CHANNELS);
+    channelRings.clear();
+    channelHistory.clear();
+    for (size_t c = 0; c < channels; c++)
+    {
+        channelRings.push_back(std::make_unique<SpscRingBuffer<float>>(RING_CAPACITY));
+        channelHistory.emplace_back(historySize);
+    }
+}
+
+void AudioSource::pushInterleaved(const float *input, size_t frames, size_t stride)
+{
+    const size_t channels = channelRings.size();
+    const DownmixMode mode = downmixMode();
+    if (channels == 0)
+        return;
+
+    // Stamp first, so the consumer never sees samples without their stamp.
+    // If the ring then drops part of the block, the stamp overstates its end
+    // by the dropped count; the consumer has already fallen behind by then.
+    const auto now = std::chrono::steady_clock::now();
+    const CaptureStamp stamp{pushedSamples + frames, now};
+    stampRing.push(&stamp, 1);
+
+    // Deinterleave once into planar chunks staged on the stack, then feed both
+    // the per-channel streams and the downmix from them. The producer thread
+    // never locks or allocates.
+    float planar[MAX_CHANNELS][PUSH_CHUNK];
+    float *planarPtrs[MAX_CHANNELS];
+    for (size_t c = 0; c < MAX_CHANNELS; c++)
+        planarPtrs[c] = planar[c];
+    float mono[PUSH_CHUNK];
+
+    for (size_t offset = 0; offset < frames; offset += PUSH_CHUNK)
+    {
+        size_t count = std::min(PUSH_CHUNK, frames - offset);
+        deinterleave(input + offset * stride, count, stride, channels, planarPtrs);
+
+        for (size_t c = 0; c < channels; c++)
+            channelRings[c]->push(planar[c], count);
+
+        // Mono sources have nothing to mix: every mode, Side included,
+        // analyzes the one channel as it is
+        if (channels == 1)
+        {
+            pushedSamples += ring.push(planar[0], count);
+            continue;
+        }
+        downmix(planar[0], planar[1], count, mode, mono);
+        pushedSamples += ring.push(mono, count);
+    }
+}
+
+void AudioSource::awaitRelease(SourcePacing pacing, std::chrono::steady_clock::time_point start, uint64_t released,
+                               size_t frames, unsigned int sampleRate, const std::atomic<bool> &running) const
+{
+    if (pacing == SourcePacing::Realtime)
+    {
+        // A device hands over a period once it has been played, so release
+        // each block at its end time
+        std::chrono::duration<double> due((released + frames) / (double)sampleRate);
+        std::this_thread::sleep_until(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(due));
+        return;
+    }
+
+    // Backpressure instead of dropping
+    while (ring.writable() < frames && running.load(std::memory_order_relaxed))
+        std::this_thread::sleep_for(FULL_WAIT);
+}
+
+void AudioSource::drain(uint64_t limit)
+{
+    // The channel histories stop at the same sequence, so they stay in step
+    // with the downmix
+    auto room = [limit](const AudioHistory &target)
+    {
+        uint64_t left = limit > target.sequence() ? limit - target.sequence() : 0;
+        return (size_t)std::min<uint64_t>(left, SIZE_MAX);
+    };
+
+    history.drain(ring, room(history));
+    for (size_t c = 0; c < channelRings.size(); c++)
+        channelHistory[c].drain(*channelRings[c], room(channelHistory[c]));
+
+    // After the samples: every drained sample's stamp is already in the ring
+    CaptureStamp stamp;
+    while (stampRing.pop(&stamp, 1) == 1)
+    {
+        stamps[stampHead] = stamp;
+        stampHead = (stampHead + 1) % stamps.size();
+    }
+}
+
+std::chrono::steady_clock::time_point AudioSource::capturedAt(uint64_t sequence) const
+{
+    // Newest first: callers ask about the latest audio almost every time
+    std::chrono::steady_clock::time_point found{};
+    for (size_t i = 1; i <= stamps.size(); i++)
+    {
+        const CaptureStamp &stamp = stamps[(stampHead + stamps.size() - i) % stamps.size()];
+        if (stamp.endSequence < sequence)
+            break;
+        found = stamp.time;
+    }
+    return found;
+}
+
+const AudioHistory &AudioSource::drainHistory()
+{
+    drain();
+    return history;
+}
+
+const AudioHistory &AudioSource::drainHistoryUpTo(uint64_t sequence)
+{
+    drain(sequence);
+    return history;
+}
+
+AudioSnapshot AudioSource::snapshot(size_t count)
+{
+    drain();
+    return history.latest(count);
+}
+
+AudioSnapshot AudioSource::channelSnapshot(size_t channel, size_t count)
+{
+    if (channel >= channelHistory.size())
+        return AudioSnapshot();
+
+    drain();
+    return channelHistory[channel].latest(count);
+}
@@ -0,0 +1,131 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "audio_history.hpp"
+#include "deinterleave.hpp"
+#include "spsc_ring_buffer.hpp"
+
+// How a source that generates its own audio (file, synthetic) hands it over
+enum class SourcePacing
+{
+    Realtime,         // Released at playback speed, like a capture device
+    AsFastAsPossible, // As fast as the consumer drains; never drops samples
+};
+
+// Where the pipeline's audio comes from: a capture device, a file, ...
+//
+// A source produces interleaved float frames on its own thread (device
+// callback, decoder thread) and hands them over with pushInterleaved(). That
+// splits them into per-channel streams plus a downmix, each behind a lock-free
+// ring, so the producer never locks or allocates. One consumer (the analysis
+// thread) drains the rings into rolling histories.
+class AudioSource
+{
+public:
+    static constexpr size_t MAX_CHANNELS = 8;
+
+    explicit AudioSource(float historySeconds = 4.0f);
+    virtual ~AudioSource() = default;
+
+    // Opens the source and starts producing
+    virtual bool init() = 0;
+
+    virtual unsigned int sampleRate() const = 0;
+
+    // True once a finite source has produced everything and it's all been
+    // drained. Live sources never finish.
+    virtual bool finished() const { return false; }
+
+    // Drains new samples and returns a contiguous view of the latest `count`
+    // downmixed samples (at most the history length). Consumer thread only;
+    // no copies, no allocation.
+    AudioSnapshot snapshot(size_t count);
+
+    // Drains new samples and returns the whole downmixed history, for callers
+    // that walk it by sequence number (e.g. the STFT). Consumer thread only.
+    const AudioHistory &drainHistory();
+
+    // Same as drainHistory(), but stops once the history reaches `sequence`
+    // and leaves anything newer queued. For consumers that step through a
+    // source running ahead of them (offline rendering): the full rings then
+    // hold the producer back, so its lead never exceeds one ring.
+    const AudioHistory &drainHistoryUpTo(uint64_t sequence);
+
+    // Same as snapshot() for a single channel (0 = left, 1 = right, ...)
+    AudioSnapshot channelSnapshot(size_t channel, size_t count);
+
+    // History of one channel as of the last drain, or nullptr if the source
+    // has no such channel. Consumer thread only.
+    const AudioHistory *channel(size_t channel) const
+    {
+        return channel < channelHistory.size() ? &channelHistory[channel] : nullptr;
+    }
+
+    size_t channelCount() const { return channelHistory.size(); }
+
+    // Picks how the analysis stream is derived from the channels; mono
+    // sources ignore it and analyze their one channel. Safe to call from any
+    // thread; applies from the next pushed block.
+    void setDownmixMode(DownmixMode mode) { mixMode.store(mode, std::memory_order_relaxed); }
+    DownmixMode downmixMode() const { return mixMode.load(std::memory_order_relaxed); }
+
+    std::uint64_t droppedSamples() const { return ring.dropped(); }
+
+    // When the downmixed sample just before `sequence` (i.e. the newest one
+    // of a window ending there) was handed over by the producer, as of the
+    // last drain. Default-constructed if that block is too old or unknown.
+    // Consumer thread only.
+    std::chrono::steady_clock::time_point capturedAt(uint64_t sequence) const;
+
+protected:
+    // Sizes the histories and per-channel streams. Call from init(), before
+    // the producer first pushes. extraSamples lengthens the histories beyond
+    // historySeconds, for producers that run far ahead of the consumer.
+    void configureStream(unsigned int sampleRate, size_t channels, size_t extraSamples = 0);
+
+    // Producer side: splits `frames` interleaved frames of `stride` samples
+    // (only the first channelCount() are used) into the streams. Never
+    // blocks; whatever doesn't fit in the rings is counted as dropped. The
+    // block is stamped with the time of the call, for latency measurement.
+    void pushInterleaved(const float *input, size_t frames, size_t stride);
+
+    // Producer side: blocks until the next `frames` frames are due. Realtime:
+    // until their playback end time, counting from `start` with `released`
+    // frames already out. AsFastAsPossible: until the rings have room for
+    // them. Returns early once `running` is cleared.
+    void awaitRelease(SourcePacing pacing, std::chrono::steady_clock::time_point start, uint64_t released,
+                      size_t frames, unsigned int sampleRate, const std::atomic<bool> &running) const;
+
+    size_t ringCapacity() const { return ring.capacity(); }
+
+    // Consumer side: samples pushed but not yet drained
+    size_t pendingSamples() const { return ring.available(); }
+
+private:
+    // One pushed block: the sequence just past its last sample, and when it arrived
+    struct CaptureStamp
+    {
+        uint64_t endSequence;
+        std::chrono::steady_clock::time_point time;
+    };
+
+    float historySeconds;
+    std::atomic<DownmixMode> mixMode{DownmixMode::Mid};
+
+    SpscRingBuffer<float> ring; // Producer -> consumer handoff, no locks on the producer
+    AudioHistory history;       // Rolling history, only touched by the consumer
+
+    // Planar per-channel streams, sized by configureStream()
+    std::vector<std::unique_ptr<SpscRingBuffer<float>>> channelRings;
+    std::vector<AudioHistory> channelHistory;
+
+    SpscRingBuffer<CaptureStamp> stampRing; // Producer -> consumer, one per pushed block
+    uint64_t pushedSamples = 0;             // Producer only: downmixed samples accepted so far
+    std::vector<CaptureStamp> stamps;       // Consumer only: the latest stamps, oldest at stampHead
+    size_t stampHead = 0;
+
+    void drain(uint64_t limit = UINT64_MAX); // Stops each history at sequence `limit`
+};
@@ -0,0 +1,66 @@
+#include "cpu_features.hpp"
+
+#if defined(SWV_X86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+
+namespace
+{
+    struct Features
+    {
+        bool avx = false;
+        bool avx2Fma = false;
+    };
+
+    Features detect()
+    {
+        Features features;
+        int info[4];
+        __cpuid(info, 0);
+        const int maxLeaf = info[0];
+
+        __cpuid(info, 1);
+        bool avx = (info[2] & (1 << 28)) != 0;
+        bool fma = (info[2] & (1 << 12)) != 0;
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        if (!avx || !osxsave || (_xgetbv(0) & 0x6) != 0x6) // OS must save YMM state
+            return features;
+        features.avx = true;
+
+        if (maxLeaf >= 7)
+        {
+            __cpuidex(info, 7, 0);
+            features.avx2Fma = fma && (info[1] & (1 << 5)) != 0;
+        }
+        return features;
+    }
+
+    const Features &features()
+    {
+        static const Features detected = detect();
+        return detected;
+    }
+}
+
+bool cpuHasAvx()
+{
+    return features().avx;
+}
+
+bool cpuHasAvx2Fma()
+{
+    return features().avx2Fma;
+}
+#else
+bool cpuHasAvx()
+{
+    return __builtin_cpu_supports("avx");
+}
+
+bool cpuHasAvx2Fma()
+{
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+}
+#endif
+#endif
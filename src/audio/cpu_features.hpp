@@ -0,0 +1,21 @@
+#pragma once
+
+// Runtime CPU feature checks for the x86 SIMD kernels.
+//
+// Builds only assume SSE2, so wider paths are compiled per function with
+// SWV_TARGET_AVX / SWV_TARGET_AVX2 and only called once these checks pass.
+// MSVC needs no attribute: its intrinsics are always available.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SWV_X86 1
+#if defined(_MSC_VER)
+#define SWV_TARGET_AVX
+#define SWV_TARGET_AVX2
+#else
+#define SWV_TARGET_AVX __attribute__((target("avx")))
+#define SWV_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#endif
+
+// Each includes the OS check that YMM state is saved across context switches
+bool cpuHasAvx();
+bool cpuHasAvx2Fma();
+#endif
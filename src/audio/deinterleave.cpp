@@ -0,0 +1,178 @@
+#include "deinterleave.hpp"
+#include <cmath>
+#include <cstring>
+#include "cpu_features.hpp"
+
+#if defined(SWV_X86)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    // Scalar versions also finish the tails the SIMD loops leave, from `i` on
+    void deinterleaveStereoScalar(const float *in, size_t i, size_t frames, float *left, float *right)
+    {
+        for (; i < frames; ++i)
+        {
+            left[i] = in[i * 2];
+            right[i] = in[i * 2 + 1];
+        }
+    }
+
+    void downmixScalar(const float *left, const float *right, size_t i, size_t frames, DownmixMode mode, float *out)
+    {
+        for (; i < frames; ++i)
+        {
+            if (mode == DownmixMode::Mid)
+                out[i] = (left[i] + right[i]) * 0.5f;
+            else if (mode == DownmixMode::Side)
+                out[i] = (left[i] - right[i]) * 0.5f;
+            else
+                out[i] = std::fabs(right[i]) > std::fabs(left[i]) ? right[i] : left[i];
+        }
+    }
+
+#if defined(SWV_X86)
+    void deinterleaveStereoSse2(const float *in, size_t frames, float *left, float *right)
+    {
+        size_t i = 0;
+        for (; i + 4 <= frames; i += 4)
+        {
+            __m128 a = _mm_loadu_ps(in + i * 2);     // L0 R0 L1 R1
+            __m128 b = _mm_loadu_ps(in + i * 2 + 4); // L2 R2 L3 R3
+            _mm_storeu_ps(left + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(right + i, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+        }
+        deinterleaveStereoScalar(in, i, frames, left, right);
+    }
+
+    SWV_TARGET_AVX2 void deinterleaveStereoAvx2(const float *in, size_t frames, float *left, float *right)
+    {
+        size_t i = 0;
+        for (; i + 8 <= frames; i += 8)
+        {
+            __m256 a = _mm256_loadu_ps(in + i * 2);     // L0 R0 L1 R1 | L2 R2 L3 R3
+            __m256 b = _mm256_loadu_ps(in + i * 2 + 8); // L4 R4 L5 R5 | L6 R6 L7 R7
+            // Per 128-bit lane: L0 L1 L4 L5 | L2 L3 L6 L7, then fix the 64-bit order
+            __m256 l = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+            __m256 r = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+            l = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(l), _MM_SHUFFLE(3, 1, 2, 0)));
+            r = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(r), _MM_SHUFFLE(3, 1, 2, 0)));
+            _mm256_storeu_ps(left + i, l);
+            _mm256_storeu_ps(right + i, r);
+        }
+        deinterleaveStereoScalar(in, i, frames, left, right);
+    }
+
+    void downmixSse2(const float *left, const float *right, size_t frames, DownmixMode mode, float *out)
+    {
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+        size_t i = 0;
+        for (; i + 4 <= frames; i += 4)
+        {
+            __m128 l = _mm_loadu_ps(left + i);
+            __m128 r = _mm_loadu_ps(right + i);
+            __m128 v;
+            if (mode == DownmixMode::Mid)
+                v = _mm_mul_ps(_mm_add_ps(l, r), half);
+            else if (mode == DownmixMode::Side)
+                v = _mm_mul_ps(_mm_sub_ps(l, r), half);
+            else
+            {
+                __m128 rLouder = _mm_cmpgt_ps(_mm_and_ps(r, absMask), _mm_and_ps(l, absMask));
+                v = _mm_or_ps(_mm_and_ps(rLouder, r), _mm_andnot_ps(rLouder, l));
+            }
+            _mm_storeu_ps(out + i, v);
+        }
+        downmixScalar(left, right, i, frames, mode, out);
+    }
+
+    SWV_TARGET_AVX void downmixAvx(const float *left, const float *right, size_t frames, DownmixMode mode, float *out)
+    {
+        const __m256 half = _mm256_set1_ps(0.5f);
+        const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+        size_t i = 0;
+        for (; i + 8 <= frames; i += 8)
+        {
+            __m256 l = _mm256_loadu_ps(left + i);
+            __m256 r = _mm256_loadu_ps(right + i);
+            __m256 v;
+            if (mode == DownmixMode::Mid)
+                v = _mm256_mul_ps(_mm256_add_ps(l, r), half);
+            else if (mode == DownmixMode::Side)
+                v = _mm256_mul_ps(_mm256_sub_ps(l, r), half);
+            else
+            {
+                __m256 rLouder = _mm256_cmp_ps(_mm256_and_ps(r, absMask), _mm256_and_ps(l, absMask), _CMP_GT_OQ);
+                v = _mm256_blendv_ps(l, r, rLouder);
+            }
+            _mm256_storeu_ps(out + i, v);
+        }
+        downmixScalar(left, right, i, frames, mode, out);
+    }
+#else
+    void deinterleaveStereoPortable(const float *in, size_t frames, float *left, float *right)
+    {
+        deinterleaveStereoScalar(in, 0, frames, left, right);
+    }
+
+    void downmixPortable(const float *left, const float *right, size_t frames, DownmixMode mode, float *out)
+    {
+        downmixScalar(left, right, 0, frames, mode, out);
+    }
+#endif
+
+    struct Kernels
+    {
+        void (*stereo)(const float *, size_t, float *, float *);
+        void (*mix)(const float *, const float *, size_t, DownmixMode, float *);
+    };
+
+    Kernels selectKernels()
+    {
+#if defined(SWV_X86)
+        return {cpuHasAvx2Fma() ? deinterleaveStereoAvx2 : deinterleaveStereoSse2,
+                cpuHasAvx() ? downmixAvx : downmixSse2};
+#else
+        return {deinterleaveStereoPortable, downmixPortable};
+#endif
+    }
+
+    const Kernels &kernels()
+    {
+        static const Kernels selected = selectKernels();
+        return selected;
+    }
+}
+
+void deinterleave(const float *interleaved, size_t frames, size_t stride, size_t channels, float *const *planar)
+{
+    if (stride == 1 && channels == 1)
+    {
+        std::memcpy(planar[0], interleaved, frames * sizeof(float));
+        return;
+    }
+    if (stride == 2 && channels == 2)
+    {
+        kernels().stereo(interleaved, frames, planar[0], planar[1]);
+        return;
+    }
+
+    for (size_t i = 0; i < frames; ++i)
+    {
+        const float *frame = interleaved + i * stride;
+        for (size_t c = 0; c < channels; ++c)
+            planar[c][i] = frame[c];
+    }
+}
+
+void downmix(const float *left, const float *right, size_t frames, DownmixMode mode, float *out)
+{
+    if (mode == DownmixMode::Left || mode == DownmixMode::Right)
+    {
+        std::memcpy(out, mode == DownmixMode::Left ? left : right, frames * sizeof(float));
+        return;
+    }
+    kernels().mix(left, right, frames, mode, out);
+}
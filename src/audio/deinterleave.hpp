@@ -0,0 +1,22 @@
+#pragma once
+#include <cstddef>
+
+// How multichannel capture is folded into the single analysis stream
+enum class DownmixMode
+{
+    Left,
+    Right,
+    Mid,   // (L + R) / 2
+    Side,  // (L - R) / 2
+    MaxAbs // Whichever of L/R has the larger magnitude, sign preserved
+};
+
+// Splits `frames` interleaved frames of `stride` channels into planar buffers
+// for the first `channels` of them. Stereo takes the widest SIMD path the CPU
+// supports (AVX2 or SSE2, picked at first use); everything else falls back to
+// scalar code.
+void deinterleave(const float *interleaved, size_t frames, size_t stride, size_t channels, float *const *planar);
+
+// Combines planar left/right buffers into `out` according to `mode` (AVX or
+// SSE2 when available)
+void downmix(const float *left, const float *right, size_t frames, DownmixMode mode, float *out);
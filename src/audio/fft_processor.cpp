@@ -1,18 +1,21 @@
 #include "fft_processor.hpp"
+#include "spectrum_kernels.hpp"
 #include <cmath>
 #include <algorithm>
 
 FftProcessor::FftProcessor(int sampleSize) : N(sampleSize)
 {
-    cfg = kiss_fft_alloc(N, 0, NULL, NULL);
-    in = new kiss_fft_cpx[N];
-    out = new kiss_fft_cpx[N];
+    N += N & 1; // kiss_fftr needs an even size
+    hop = N / 2;
+    cfg = kiss_fftr_alloc(N, 0, NULL, NULL);
+    in = new kiss_fft_scalar[N];
+    out = new kiss_fft_cpx[N / 2 + 1];
     createHanningWindow();
 }
 
 FftProcessor::~FftProcessor()
 {
-    free(cfg);
+    kiss_fftr_free(cfg);
     delete[] in;
     delete[] out;
 }
@@ -26,27 +29,30 @@ void FftProcessor::createHanningWindow()
     }
 }
 
-void FftProcessor::calculate(const std::vector<float> &audioData, std::vector<float> &outputBars)
+bool FftProcessor::calculate(const AudioSnapshot &audio, std::vector<float> &outputBars)
 {
-    if (audioData.size() < N)
-        return;
+    if (audio.size() < (size_t)N || audio.sequence == lastSequence)
+        return false;
+    lastSequence = audio.sequence;
 
+    // Use the newest N samples
+    transform(audio.data + (audio.size() - N), outputBars);
+    return true;
+}
+
+void FftProcessor::transform(const float *samples, std::vector<float> &outputBars)
+{
     for (int i = 0; i < N; ++i)
     {
-        in[i].r = audioData[i] * window[i];
-        in[i].i = 0;
+        in[i] = samples[i] * window[i];
     }
 
-    kiss_fft(cfg, in, out);
+    kiss_fftr(cfg, in, out);
 
-    int usefulBins = N / 2;
+    int usefulBins = N / 2 + 1;
     if (outputBars.size() != usefulBins)
         outputBars.resize(usefulBins);
 
-    for (int i = 0; i < usefulBins; ++i)
-    {
-        float magnitude = std::sqrt(out[i].r * out[i].r + out[i].i * out[i].i);
-        float db = 20.0f * std::log10(magnitude + 1.0f);
-        outputBars[i] = db / 60.0f; // Normalize
-    }
+    // 20 * log10(|X| + 1), normalized so 60 dB maps to 1.0
+    magnitudeToDb(out, usefulBins, 1.0f / 60.0f, outputBars.data());
 }
\ No newline at end of file
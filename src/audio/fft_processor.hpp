@@ -1,7 +1,10 @@
 #pragma once
+#include <algorithm>
 #include <vector>
 #include <complex>
-#include "kissfft/kiss_fft.h"
+#include "kissfft/kiss_fftr.h"
+#include "audio_history.hpp"
+#include "audio_snapshot.hpp"
 
 class FftProcessor
 {
@@ -9,14 +12,71 @@ public:
     FftProcessor(int sampleSize = 1024);
     ~FftProcessor();
 
-    void calculate(const std::vector<float> &audioData, std::vector<float> &outputBars);
+    // Reads the window straight out of capture memory and writes N/2 + 1
+    // normalized bins. Returns false (leaving outputBars untouched) when the
+    // snapshot holds no new samples.
+    bool calculate(const AudioSnapshot &audio, std::vector<float> &outputBars);
+
+    // === STFT mode ===
+    // Analyzes the stream at every hop of `hopSize` samples (e.g. N/2 for 50%
+    // overlap) regardless of how often it is called, so the spectrum rate is
+    // tied to audio time instead of the caller's frame rate.
+    void setHopSize(int hopSize) { hop = std::max(1, hopSize); }
+    int hopSize() const { return hop; }
+    int size() const { return N; }
+
+    // Runs one FFT for every hop whose window has fully arrived in `history`
+    // since the last call and calls emit(bins, endSequence) for each, oldest
+    // first. endSequence is the sample sequence at the end of that window.
+    // Hops that already scrolled out of the history are skipped and counted.
+    // Returns the number of spectra emitted.
+    template <typename Emit>
+    size_t processHops(const AudioHistory &history, Emit &&emit)
+    {
+        if (history.capacity() < (size_t)N)
+            return 0;
+
+        const uint64_t newest = history.sequence();
+        if (nextHopEnd == 0)
+            nextHopEnd = N;
+
+        // Fell too far behind: resume from the oldest window still in history
+        const uint64_t reach = history.capacity() - N;
+        if (newest > nextHopEnd + reach)
+        {
+            uint64_t behind = (newest - reach - nextHopEnd + hop - 1) / hop;
+            skippedHops += behind;
+            nextHopEnd += behind * hop;
+        }
+
+        size_t emitted = 0;
+        for (; nextHopEnd <= newest; nextHopEnd += hop)
+        {
+            transform(history.ending(nextHopEnd, N).data, hopBins);
+            emit(hopBins, nextHopEnd);
+            ++emitted;
+        }
+        return emitted;
+    }
+
+    uint64_t hopsSkipped() const { return skippedHops; }
+
+    // Drops any pending hops; the next window analyzed ends at `sequence`
+    void restartHops(uint64_t sequence) { nextHopEnd = std::max<uint64_t>(sequence, N); }
 
 private:
     int N;
-    kiss_fft_cfg cfg;
-    kiss_fft_cpx *in;
+    kiss_fftr_cfg cfg; // Real-input FFT: half the work of a complex FFT of size N
+    kiss_fft_scalar *in;
     kiss_fft_cpx *out;
     std::vector<float> window;
+    uint64_t lastSequence = 0;
+
+    int hop;
+    uint64_t nextHopEnd = 0;
+    uint64_t skippedHops = 0;
+    std::vector<float> hopBins;
 
     void createHanningWindow();
+    void transform(const float *samples, std::vector<float> &outputBars);
 };
\ No newline at end of file
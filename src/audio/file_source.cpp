@@ -0,0 +1,127 @@
+#include "file_source.hpp"
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    // Frames per decode; also the release granularity in realtime mode
+    // (~12 ms at 44.1 kHz, close to a device period)
+    constexpr ma_uint64 DECODE_CHUNK = 512;
+
+    // Decoded blocks held ahead of the release clock (~93 ms at 44.1 kHz):
+    // a slow read eats into this lead instead of delaying releases
+    constexpr size_t PREFETCH_BLOCKS = 8;
+}
+
+FileSource::FileSource(const std::string &path, SourcePacing pacing, float historySeconds)
+    : AudioSource(historySeconds), m_path(path), m_pacing(pacing)
+{
+}
+
+FileSource::~FileSource()
+{
+    stop();
+    if (m_decoderReady)
+        ma_decoder_uninit(&m_decoder);
+}
+
+bool FileSource::init()
+{
+    ma_decoder_config config = ma_decoder_config_init(ma_format_f32, 0, 0);
+    if (ma_decoder_init_file(m_path.c_str(), &config, &m_decoder) != MA_SUCCESS)
+    {
+        std::cerr << "[ERROR] Failed to open audio file '" << m_path << "'" << std::endl;
+        return false;
+    }
+    m_decoderReady = true;
+
+    // More channels than the pipeline carries: let miniaudio fold to stereo
+    if (m_decoder.outputChannels > MAX_CHANNELS)
+    {
+        ma_decoder_uninit(&m_decoder);
+        config = ma_decoder_config_init(ma_format_f32, 2, 0);
+        m_decoderReady = ma_decoder_init_file(m_path.c_str(), &config, &m_decoder) == MA_SUCCESS;
+        if (!m_decoderReady)
+            return false;
+    }
+
+    m_sampleRate = m_decoder.outputSampleRate;
+    m_channels = m_decoder.outputChannels;
+
+    // Running ahead, the decoder can fill a whole ring before the consumer
+    // drains it; size the histories so historySeconds of lookback remain
+    size_t lead = m_pacing == SourcePacing::AsFastAsPossible ? ringCapacity() : 0;
+    configureStream(m_sampleRate, m_channels, lead);
+
+    m_running = true;
+    m_worker = std::thread(&FileSource::run, this);
+    return true;
+}
+
+void FileSource::stop()
+{
+    m_running = false;
+    if (m_worker.joinable())
+        m_worker.join();
+}
+
+bool FileSource::finished() const
+{
+    return m_endOfFile.load(std::memory_order_acquire) && pendingSamples() == 0;
+}
+
+void FileSource::run()
+{
+    // Decoded blocks queue up in a small ring of slots, oldest at `head`
+    const size_t blockSamples = DECODE_CHUNK * m_channels;
+    std::vector<float> blocks(PREFETCH_BLOCKS * blockSamples);
+    ma_uint64 frames[PREFETCH_BLOCKS] = {};
+    size_t head = 0;
+    size_t queued = 0;
+    bool endOfFile = false;
+
+    const auto start = std::chrono::steady_clock::now();
+    uint64_t released = 0;
+
+    // Whether the oldest queued block is already past its release time
+    auto overdue = [&]()
+    {
+        if (m_pacing != SourcePacing::Realtime)
+            return false;
+        std::chrono::duration<double> due((released + frames[head]) / (double)m_sampleRate);
+        return std::chrono::steady_clock::now() >=
+               start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(due);
+    };
+
+    while (m_running.load(std::memory_order_relaxed))
+    {
+        // Top up while there is slack before the next release; once a block
+        // is overdue, release from the queue first and decode afterwards
+        while (!endOfFile && queued < PREFETCH_BLOCKS && (queued == 0 || !overdue()))
+        {
+            size_t slot = (head + queued) % PREFETCH_BLOCKS;
+            ma_uint64 read = 0;
+            ma_result result =
+                ma_decoder_read_pcm_frames(&m_decoder, &blocks[slot * blockSamples], DECODE_CHUNK, &read);
+            if (read > 0)
+            {
+                frames[slot] = read;
+                queued++;
+            }
+            if (result != MA_SUCCESS || read < DECODE_CHUNK)
+                endOfFile = true;
+        }
+
+        if (queued == 0)
+            break;
+
+        awaitRelease(m_pacing, start, released, (size_t)frames[head], m_sampleRate, m_running);
+        pushInterleaved(&blocks[head * blockSamples], (size_t)frames[head], m_channels);
+        released += frames[head];
+        head = (head + 1) % PREFETCH_BLOCKS;
+        queued--;
+    }
+
+    m_endOfFile.store(true, std::memory_order_release);
+}
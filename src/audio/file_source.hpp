@@ -0,0 +1,38 @@
+#pragma once
+#include <atomic>
+#include <string>
+#include <thread>
+#include "miniaudio.h"
+#include "audio_source.hpp"
+
+// Audio file (WAV, FLAC, MP3) decoded by miniaudio on a background thread.
+//
+// The thread keeps several decoded blocks queued ahead of their release time
+// (or of ring space), so a slow decoder read doesn't stall the consumer.
+// Output keeps the file's sample rate and channel layout.
+class FileSource : public AudioSource
+{
+public:
+    FileSource(const std::string &path, SourcePacing pacing, float historySeconds = 4.0f);
+    ~FileSource() override;
+
+    bool init() override;
+    unsigned int sampleRate() const override { return m_sampleRate; }
+    bool finished() const override;
+
+    void stop();
+
+private:
+    std::string m_path;
+    SourcePacing m_pacing;
+    ma_decoder m_decoder;
+    bool m_decoderReady = false;
+    unsigned int m_sampleRate = 0;
+    unsigned int m_channels = 0;
+
+    std::thread m_worker;
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_endOfFile{false};
+
+    void run();
+};
@@ -0,0 +1,176 @@
+#include "spectrum_kernels.hpp"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include "cpu_features.hpp"
+
+#if defined(SWV_X86)
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64) // vsqrtq_f32 is AArch64 only
+#define SWV_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+    // log2(1 + f) ~= f * (C1 + f * (C2 + f * (C3 + f * (C4 + f * C5)))) for f in [0, 1)
+    constexpr float C1 = 1.44196504f;
+    constexpr float C2 = -0.709657283f;
+    constexpr float C3 = 0.417579089f;
+    constexpr float C4 = -0.196249747f;
+    constexpr float C5 = 0.0463771836f;
+
+    constexpr float DB_PER_LOG2 = 6.02059991f; // 20 * log10(2)
+
+    // Input is always >= 1, so there are no zeros, negatives or denormals to handle
+    inline float fastLog2(float x)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        float exponent = (float)((int)(bits >> 23) - 127);
+        bits = (bits & 0x007fffffu) | 0x3f800000u;
+        float m;
+        std::memcpy(&m, &bits, sizeof(m));
+        float f = m - 1.0f;
+        return exponent + f * (C1 + f * (C2 + f * (C3 + f * (C4 + f * C5))));
+    }
+
+    void magnitudeToDbScalar(const kiss_fft_cpx *bins, size_t count, float scale, float *out)
+    {
+        const float k = DB_PER_LOG2 * scale;
+        for (size_t i = 0; i < count; ++i)
+        {
+            float magnitude = std::sqrt(bins[i].r * bins[i].r + bins[i].i * bins[i].i);
+            out[i] = fastLog2(magnitude + 1.0f) * k;
+        }
+    }
+
+#if defined(SWV_X86)
+    void magnitudeToDbSse2(const kiss_fft_cpx *bins, size_t count, float scale, float *out)
+    {
+        const float *in = (const float *)bins;
+        const __m128 k = _mm_set1_ps(DB_PER_LOG2 * scale);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128i mantissaMask = _mm_set1_epi32(0x007fffff);
+        const __m128i bias = _mm_set1_epi32(127);
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 a = _mm_loadu_ps(in + i * 2);     // r0 i0 r1 i1
+            __m128 b = _mm_loadu_ps(in + i * 2 + 4); // r2 i2 r3 i3
+            a = _mm_mul_ps(a, a);
+            b = _mm_mul_ps(b, b);
+            __m128 power = _mm_add_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)),
+                                      _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+            __m128i bits = _mm_castps_si128(_mm_add_ps(_mm_sqrt_ps(power), one));
+
+            __m128 exponent = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), bias));
+            __m128 f = _mm_sub_ps(_mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, mantissaMask), _mm_castps_si128(one))), one);
+
+            __m128 p = _mm_set1_ps(C5);
+            p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(C4));
+            p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(C3));
+            p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(C2));
+            p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(C1));
+            __m128 log2 = _mm_add_ps(exponent, _mm_mul_ps(p, f));
+
+            _mm_storeu_ps(out + i, _mm_mul_ps(log2, k));
+        }
+        magnitudeToDbScalar(bins + i, count - i, scale, out + i);
+    }
+
+    SWV_TARGET_AVX2 void magnitudeToDbAvx2(const kiss_fft_cpx *bins, size_t count, float scale, float *out)
+    {
+        const float *in = (const float *)bins;
+        const __m256 k = _mm256_set1_ps(DB_PER_LOG2 * scale);
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256i mantissaMask = _mm256_set1_epi32(0x007fffff);
+        const __m256i bias = _mm256_set1_epi32(127);
+
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 a = _mm256_loadu_ps(in + i * 2);     // bins 0-3
+            __m256 b = _mm256_loadu_ps(in + i * 2 + 8); // bins 4-7
+            // Per 128-bit lane: 0 1 4 5 | 2 3 6 7, then fix the 64-bit order
+            __m256 power = _mm256_hadd_ps(_mm256_mul_ps(a, a), _mm256_mul_ps(b, b));
+            power = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(power), _MM_SHUFFLE(3, 1, 2, 0)));
+            __m256i bits = _mm256_castps_si256(_mm256_add_ps(_mm256_sqrt_ps(power), one));
+
+            __m256 exponent = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), bias));
+            __m256 f = _mm256_sub_ps(_mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, mantissaMask), _mm256_castps_si256(one))), one);
+
+            __m256 p = _mm256_fmadd_ps(_mm256_set1_ps(C5), f, _mm256_set1_ps(C4));
+            p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(C3));
+            p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(C2));
+            p = _mm256_fmadd_ps(p, f, _mm256_set1_ps(C1));
+            __m256 log2 = _mm256_fmadd_ps(p, f, exponent);
+
+            _mm256_storeu_ps(out + i, _mm256_mul_ps(log2, k));
+        }
+        magnitudeToDbScalar(bins + i, count - i, scale, out + i);
+    }
+#endif
+
+#if defined(SWV_NEON)
+    void magnitudeToDbNeon(const kiss_fft_cpx *bins, size_t count, float scale, float *out)
+    {
+        const float *in = (const float *)bins;
+        const float32x4_t k = vdupq_n_f32(DB_PER_LOG2 * scale);
+        const float32x4_t one = vdupq_n_f32(1.0f);
+        const uint32x4_t mantissaMask = vdupq_n_u32(0x007fffff);
+        const int32x4_t bias = vdupq_n_s32(127);
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            float32x4x2_t c = vld2q_f32(in + i * 2); // Splits re / im for us
+            float32x4_t power = vmlaq_f32(vmulq_f32(c.val[0], c.val[0]), c.val[1], c.val[1]);
+            uint32x4_t bits = vreinterpretq_u32_f32(vaddq_f32(vsqrtq_f32(power), one));
+
+            float32x4_t exponent = vcvtq_f32_s32(vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(bits, 23)), bias));
+            float32x4_t f = vsubq_f32(vreinterpretq_f32_u32(vorrq_u32(vandq_u32(bits, mantissaMask), vreinterpretq_u32_f32(one))), one);
+
+            float32x4_t p = vmlaq_f32(vdupq_n_f32(C4), vdupq_n_f32(C5), f);
+            p = vmlaq_f32(vdupq_n_f32(C3), p, f);
+            p = vmlaq_f32(vdupq_n_f32(C2), p, f);
+            p = vmlaq_f32(vdupq_n_f32(C1), p, f);
+            float32x4_t log2 = vmlaq_f32(exponent, p, f);
+
+            vst1q_f32(out + i, vmulq_f32(log2, k));
+        }
+        magnitudeToDbScalar(bins + i, count - i, scale, out + i);
+    }
+#endif
+
+    const MagnitudeToDbKernel &kernel()
+    {
+        // The widest one comes last
+        static const MagnitudeToDbKernel selected = magnitudeToDbKernels().back();
+        return selected;
+    }
+}
+
+std::vector<MagnitudeToDbKernel> magnitudeToDbKernels()
+{
+    std::vector<MagnitudeToDbKernel> kernels{{magnitudeToDbScalar, "scalar"}};
+#if defined(SWV_X86)
+    kernels.push_back({magnitudeToDbSse2, "sse2"});
+    if (cpuHasAvx2Fma())
+        kernels.push_back({magnitudeToDbAvx2, "avx2"});
+#elif defined(SWV_NEON)
+    kernels.push_back({magnitudeToDbNeon, "neon"});
+#endif
+    return kernels;
+}
+
+void magnitudeToDb(const kiss_fft_cpx *bins, size_t count, float scale, float *out)
+{
+    kernel().fn(bins, count, scale, out);
+}
+
+const char *magnitudeToDbKernelName()
+{
+    return kernel().name;
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "kissfft/kiss_fft.h"
+
+// Converts complex FFT bins to scaled dB in one pass:
+//
+//   out[i] = 20 * log10(|X| + 1) * scale
+//
+// the same curve the bars have always been tuned to. The sqrt is one vector
+// instruction per lane, and log10 comes from a degree-5 polynomial log2
+// approximation (|error| < 1.5e-5 in log2, i.e. under 1e-4 dB). The widest
+// implementation the CPU supports (AVX2+FMA, SSE2, AArch64 NEON or scalar)
+// is picked once at first use.
+void magnitudeToDb(const kiss_fft_cpx *bins, size_t count, float scale, float *out);
+
+// Name of the implementation magnitudeToDb() dispatches to, for logging
+const char *magnitudeToDbKernelName();
+
+struct MagnitudeToDbKernel
+{
+    void (*fn)(const kiss_fft_cpx *bins, size_t count, float scale, float *out);
+    const char *name;
+};
+
+// Every implementation this build and CPU can run, widest last; for tests
+// and benchmarks that check each path, not just the dispatched one
+std::vector<MagnitudeToDbKernel> magnitudeToDbKernels();
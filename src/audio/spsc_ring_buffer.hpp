@@ -0,0 +1,127 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// Wait-free single-producer / single-consumer ring buffer.
+//
+// The producer (the audio callback) only ever writes m_write and the consumer
+// only ever writes m_read, so neither side takes a lock or allocates after
+// construction. Capacity is rounded up to a power of two so positions wrap with
+// a mask, and each index lives on its own cache line to avoid false sharing.
+//
+// When the buffer is full, push() accepts what fits and counts the rest as
+// dropped instead of overwriting samples the consumer may be reading.
+template <typename T>
+class SpscRingBuffer
+{
+    static_assert(std::is_trivially_copyable<T>::value, "SpscRingBuffer copies elements with memcpy");
+
+public:
+    static constexpr std::size_t kCacheLine = 64;
+
+    explicit SpscRingBuffer(std::size_t minCapacity)
+    {
+        std::size_t capacity = 1;
+        while (capacity < minCapacity)
+            capacity <<= 1;
+
+        m_data.resize(capacity);
+        m_mask = capacity - 1;
+    }
+
+    SpscRingBuffer(const SpscRingBuffer &) = delete;
+    SpscRingBuffer &operator=(const SpscRingBuffer &) = delete;
+
+    std::size_t capacity() const { return m_data.size(); }
+
+    // Producer side. Returns the number of elements accepted.
+    std::size_t push(const T *src, std::size_t count)
+    {
+        const std::size_t write = m_write.load(std::memory_order_relaxed);
+        std::size_t freeSpace = capacity() - (write - m_cachedRead);
+        if (freeSpace < count)
+        {
+            // Refresh our view of the consumer only when the cached one says we're short
+            m_cachedRead = m_read.load(std::memory_order_acquire);
+            freeSpace = capacity() - (write - m_cachedRead);
+        }
+
+        const std::size_t accepted = count < freeSpace ? count : freeSpace;
+        if (accepted < count)
+            m_dropped.fetch_add(count - accepted, std::memory_order_relaxed);
+        if (accepted == 0)
+            return 0;
+
+        copyIn(write & m_mask, src, accepted);
+        m_write.store(write + accepted, std::memory_order_release);
+        return accepted;
+    }
+
+    // Consumer side. Returns the number of elements copied into dest.
+    std::size_t pop(T *dest, std::size_t count)
+    {
+        const std::size_t read = m_read.load(std::memory_order_relaxed);
+        std::size_t ready = m_cachedWrite - read;
+        if (ready < count)
+        {
+            m_cachedWrite = m_write.load(std::memory_order_acquire);
+            ready = m_cachedWrite - read;
+        }
+
+        const std::size_t taken = count < ready ? count : ready;
+        if (taken == 0)
+            return 0;
+
+        copyOut(read & m_mask, dest, taken);
+        m_read.store(read + taken, std::memory_order_release);
+        return taken;
+    }
+
+    // Producer side. Number of elements push() would accept right now.
+    std::size_t writable() const
+    {
+        return capacity() - (m_write.load(std::memory_order_relaxed) - m_read.load(std::memory_order_acquire));
+    }
+
+    // Consumer side. Number of elements ready to pop.
+    std::size_t available() const
+    {
+        return m_write.load(std::memory_order_acquire) - m_read.load(std::memory_order_relaxed);
+    }
+
+    // Total elements rejected by push() because the consumer fell behind
+    std::uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    void copyIn(std::size_t start, const T *src, std::size_t count)
+    {
+        const std::size_t first = count < capacity() - start ? count : capacity() - start;
+        std::memcpy(m_data.data() + start, src, first * sizeof(T));
+        if (count > first)
+            std::memcpy(m_data.data(), src + first, (count - first) * sizeof(T));
+    }
+
+    void copyOut(std::size_t start, T *dest, std::size_t count) const
+    {
+        const std::size_t first = count < capacity() - start ? count : capacity() - start;
+        std::memcpy(dest, m_data.data() + start, first * sizeof(T));
+        if (count > first)
+            std::memcpy(dest + first, m_data.data(), (count - first) * sizeof(T));
+    }
+
+    std::vector<T> m_data;
+    std::size_t m_mask = 0;
+
+    // Producer-owned line: write position plus its cached copy of the read position
+    alignas(kCacheLine) std::atomic<std::size_t> m_write{0};
+    std::size_t m_cachedRead = 0;
+    std::atomic<std::uint64_t> m_dropped{0};
+
+    // Consumer-owned line: read position plus its cached copy of the write position
+    alignas(kCacheLine) std::atomic<std::size_t> m_read{0};
+    std::size_t m_cachedWrite = 0;
+};
@@ -0,0 +1,268 @@
+#include "synthetic_source.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    constexpr size_t GENERATE_CHUNK = 512;  // Frames per block, like a device period
+    constexpr double TWO_PI = 6.283185307179586;
+
+    constexpr double SWEEP_START = 20.0;    // Hz
+    constexpr double SWEEP_END = 20000.0;   // Hz
+    constexpr double SWEEP_SECONDS = 10.0;  // One pass, then it starts over
+    constexpr double BURST_SECONDS = 0.05;  // Length of each tone burst
+
+    // The pink filter's output is ~3x its input; this keeps it mostly in -1..1
+    constexpr float PINK_GAIN = 0.25f;
+
+    bool parseNumber(const char *text, float &value)
+    {
+        char *end = nullptr;
+        float parsed = std::strtof(text, &end);
+        if (end == text || *end != '\0' || !(parsed >= 0.0f))
+            return false;
+        value = parsed;
+        return true;
+    }
+}
+
+bool parseSignalKind(const std::string &name, SignalKind &kind)
+{
+    static const struct
+    {
+        const char *name;
+        SignalKind kind;
+    } KINDS[] = {
+        {"sine", SignalKind::Sine},
+        {"sweep", SignalKind::Sweep},
+        {"white", SignalKind::White},
+        {"pink", SignalKind::Pink},
+        {"impulses", SignalKind::Impulses},
+        {"bursts", SignalKind::Bursts},
+    };
+
+    for (const auto &entry : KINDS)
+    {
+        if (name == entry.name)
+        {
+            kind = entry.kind;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseSignalOptions(int argc, char **argv, SignalSpec &spec, bool &requested)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string flag = argv[i];
+        if (flag != "--synthetic" && flag != "--seed" && flag != "--frequency" && flag != "--rate" && flag != "--seconds")
+            continue;
+
+        if (i + 1 >= argc)
+        {
+            std::cerr << "[ERROR] " << flag << " needs a value" << std::endl;
+            return false;
+        }
+        std::string value = argv[++i];
+
+        bool ok = true;
+        if (flag == "--synthetic")
+        {
+            ok = parseSignalKind(value, spec.kind);
+            requested = true;
+        }
+        else if (flag == "--seed")
+        {
+            char *end = nullptr;
+            unsigned long seed = std::strtoul(value.c_str(), &end, 10);
+            ok = end != value.c_str() && *end == '\0';
+            spec.seed = (std::uint32_t)seed;
+        }
+        else if (flag == "--frequency")
+            ok = parseNumber(value.c_str(), spec.frequency) && spec.frequency > 0.0f;
+        else if (flag == "--rate")
+            ok = parseNumber(value.c_str(), spec.rate) && spec.rate > 0.0f;
+        else if (flag == "--seconds")
+            ok = parseNumber(value.c_str(), spec.seconds);
+
+        if (!ok)
+        {
+            std::cerr << "[ERROR] Invalid value for " << flag << ": '" << value << "'" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+SyntheticSource::SyntheticSource(const SignalSpec &spec, SourcePacing pacing, float historySeconds)
+    : AudioSource(historySeconds), m_spec(spec), m_pacing(pacing)
+{
+    m_spec.channels = std::min<unsigned int>(std::max(1u, m_spec.channels), MAX_CHANNELS);
+
+    // Spread the seed so nearby seeds give unrelated streams (splitmix32 finalizer)
+    std::uint32_t z = m_spec.seed + 0x9E3779B9u;
+    z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+    z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+    z ^= z >> 16;
+    m_noise = z != 0 ? z : 1;
+}
+
+SyntheticSource::~SyntheticSource()
+{
+    stop();
+}
+
+bool SyntheticSource::init()
+{
+    if (m_spec.sampleRate == 0)
+    {
+        std::cerr << "[ERROR] Synthetic source needs a sample rate" << std::endl;
+        return false;
+    }
+
+    // Same reasoning as FileSource: running ahead can fill a whole ring
+    size_t lead = m_pacing == SourcePacing::AsFastAsPossible ? ringCapacity() : 0;
+    configureStream(m_spec.sampleRate, m_spec.channels, lead);
+
+    m_running = true;
+    m_worker = std::thread(&SyntheticSource::run, this);
+    return true;
+}
+
+void SyntheticSource::stop()
+{
+    m_running = false;
+    if (m_worker.joinable())
+        m_worker.join();
+}
+
+bool SyntheticSource::finished() const
+{
+    return m_endOfSignal.load(std::memory_order_acquire) && pendingSamples() == 0;
+}
+
+float SyntheticSource::whiteSample()
+{
+    // xorshift32: the same sequence on every platform, unlike std::rand or
+    // the <random> distributions
+    m_noise ^= m_noise << 13;
+    m_noise ^= m_noise >> 17;
+    m_noise ^= m_noise << 5;
+    return (float)(m_noise >> 8) * (2.0f / 16777216.0f) - 1.0f;
+}
+
+void SyntheticSource::generate(float *out, size_t frames)
+{
+    const double rate = m_spec.sampleRate;
+    const float amplitude = m_spec.amplitude;
+
+    switch (m_spec.kind)
+    {
+    case SignalKind::Sine:
+    {
+        const double step = m_spec.frequency / rate;
+        for (size_t i = 0; i < frames; ++i)
+        {
+            out[i] = amplitude * (float)std::sin(TWO_PI * m_phase);
+            m_phase += step;
+            m_phase -= std::floor(m_phase);
+        }
+        break;
+    }
+    case SignalKind::Sweep:
+    {
+        // Exponential sweep: equal time per octave
+        const uint64_t pass = (uint64_t)(SWEEP_SECONDS * rate);
+        const double octaves = std::log2(SWEEP_END / SWEEP_START);
+        for (size_t i = 0; i < frames; ++i)
+        {
+            double t = (double)((m_position + i) % pass) / pass;
+            out[i] = amplitude * (float)std::sin(TWO_PI * m_phase);
+            m_phase += SWEEP_START * std::exp2(octaves * t) / rate;
+            m_phase -= std::floor(m_phase);
+        }
+        break;
+    }
+    case SignalKind::White:
+        for (size_t i = 0; i < frames; ++i)
+            out[i] = amplitude * whiteSample();
+        break;
+    case SignalKind::Pink:
+        // Paul Kellet's economy filter: three poles give -3 dB/octave to
+        // within ~0.5 dB across the audio band
+        for (size_t i = 0; i < frames; ++i)
+        {
+            float white = whiteSample();
+            m_pink[0] = 0.99765f * m_pink[0] + white * 0.0990460f;
+            m_pink[1] = 0.96300f * m_pink[1] + white * 0.2965164f;
+            m_pink[2] = 0.57000f * m_pink[2] + white * 1.0526913f;
+            float pink = (m_pink[0] + m_pink[1] + m_pink[2] + white * 0.1848f) * PINK_GAIN;
+            out[i] = amplitude * std::clamp(pink, -1.0f, 1.0f);
+        }
+        break;
+    case SignalKind::Impulses:
+    {
+        const uint64_t period = std::max<uint64_t>(1, (uint64_t)std::llround(rate / m_spec.rate));
+        for (size_t i = 0; i < frames; ++i)
+            out[i] = (m_position + i) % period == 0 ? amplitude : 0.0f;
+        break;
+    }
+    case SignalKind::Bursts:
+    {
+        // Every burst starts at phase zero, so all of them are identical
+        const uint64_t period = std::max<uint64_t>(1, (uint64_t)std::llround(rate / m_spec.rate));
+        const uint64_t length = std::min(period, (uint64_t)(BURST_SECONDS * rate));
+        const double step = m_spec.frequency / rate;
+        for (size_t i = 0; i < frames; ++i)
+        {
+            uint64_t offset = (m_position + i) % period;
+            out[i] = offset < length ? amplitude * (float)std::sin(TWO_PI * std::fmod(offset * step, 1.0)) : 0.0f;
+        }
+        break;
+    }
+    }
+
+    m_position += frames;
+}
+
+void SyntheticSource::run()
+{
+    const size_t channels = m_spec.channels;
+    const uint64_t total = (uint64_t)std::llround(m_spec.seconds * m_spec.sampleRate);
+    std::vector<float> mono(GENERATE_CHUNK);
+    std::vector<float> block(GENERATE_CHUNK * channels);
+    const auto start = std::chrono::steady_clock::now();
+
+    while (m_running.load(std::memory_order_relaxed))
+    {
+        size_t frames = GENERATE_CHUNK;
+        if (total > 0)
+        {
+            if (m_position >= total)
+                break;
+            frames = (size_t)std::min<uint64_t>(frames, total - m_position);
+        }
+
+        const uint64_t released = m_position;
+        generate(mono.data(), frames);
+
+        const float *src = mono.data();
+        if (channels > 1)
+        {
+            for (size_t i = 0; i < frames; ++i)
+                std::fill_n(&block[i * channels], channels, mono[i]);
+            src = block.data();
+        }
+
+        awaitRelease(m_pacing, start, released, frames, m_spec.sampleRate, m_running);
+        pushInterleaved(src, frames, channels);
+    }
+
+    m_endOfSignal.store(true, std::memory_order_release);
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include "audio_source.hpp"
+
+enum class SignalKind
+{
+    Sine,      // Steady tone at `frequency`
+    Sweep,     // Logarithmic 20 Hz - 20 kHz sweep, repeating
+    White,     // White noise
+    Pink,      // Pink (-3 dB/octave) noise
+    Impulses,  // Single-sample clicks, `rate` per second
+    Bursts,    // Tone bursts at `frequency`, `rate` per second
+};
+
+struct SignalSpec
+{
+    SignalKind kind = SignalKind::Sweep;
+    float frequency = 440.0f;      // Tone of Sine and Bursts (Hz)
+    float rate = 2.0f;             // Impulses / bursts per second
+    float amplitude = 0.5f;        // Peak level, 0..1
+    float seconds = 0.0f;          // Length; 0 = endless
+    std::uint32_t seed = 1;        // Noise seed; same seed, same samples
+    unsigned int sampleRate = 44100;
+    unsigned int channels = 2;     // Every channel carries the same signal
+};
+
+// Maps "sine", "sweep", "white", "pink", "impulses", "bursts" to a kind
+bool parseSignalKind(const std::string &name, SignalKind &kind);
+
+// Reads --synthetic <kind> [--seed N] [--frequency Hz] [--rate N]
+// [--seconds S]. Sets `requested` when --synthetic is given; returns false
+// after printing why on bad values.
+bool parseSignalOptions(int argc, char **argv, SignalSpec &spec, bool &requested);
+
+// Deterministic test signal generated on a background thread and fed through
+// the same handoff as a capture device, so benchmarks exercise the real
+// ring / history / FFT path with reproducible input. The samples depend only
+// on the spec, never on timing or pacing.
+class SyntheticSource : public AudioSource
+{
+public:
+    SyntheticSource(const SignalSpec &spec, SourcePacing pacing, float historySeconds = 4.0f);
+    ~SyntheticSource() override;
+
+    bool init() override;
+    unsigned int sampleRate() const override { return m_spec.sampleRate; }
+    bool finished() const override;
+
+    void stop();
+
+    // Fills `frames` mono samples and advances the signal. The producer
+    // thread's entry point; call it directly only on a source that was never
+    // started, e.g. to reproduce the exact input a run saw.
+    void generate(float *out, size_t frames);
+
+private:
+    SignalSpec m_spec;
+    SourcePacing m_pacing;
+
+    // Generator state
+    std::uint64_t m_position = 0; // Frames generated so far
+    double m_phase = 0.0;         // Oscillator phase in cycles
+    std::uint32_t m_noise;        // xorshift32 state, never zero
+    float m_pink[3] = {};         // Pink filter poles
+
+    std::thread m_worker;
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_endOfSignal{false};
+
+    float whiteSample();
+    void run();
+};
@@ -0,0 +1,22 @@
+#include "wave_trigger.hpp"
+
+long findLastRisingEdge(const float *samples, size_t count, float hysteresis)
+{
+    long found = -1;
+    bool armed = false;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        float s = samples[i];
+        if (s < -hysteresis)
+        {
+            armed = true;
+        }
+        else if (armed && s >= 0.0f)
+        {
+            found = static_cast<long>(i);
+            armed = false;
+        }
+    }
+    return found;
+}
@@ -0,0 +1,10 @@
+#pragma once
+#include <cstddef>
+
+// Oscilloscope trigger: index of the last rising zero crossing in
+// samples[0, count), or -1 if there is none.
+//
+// The trigger arms only once the signal has dropped below -hysteresis, so
+// noise hovering around zero doesn't retrigger. Cost is O(count), which the
+// caller bounds by how far back it lets the search go.
+long findLastRisingEdge(const float *samples, size_t count, float hysteresis);
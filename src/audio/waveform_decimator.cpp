@@ -0,0 +1,125 @@
+#include "waveform_decimator.hpp"
+#include <algorithm>
+#include "cpu_features.hpp"
+
+#if defined(SWV_X86)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    using MinMaxFn = void (*)(const float *, size_t, float &, float &);
+
+    // Folds samples[i, count) into lo/hi; also finishes the SIMD tails
+    void minMaxScalar(const float *samples, size_t i, size_t count, float &lo, float &hi)
+    {
+        for (; i < count; ++i)
+        {
+            lo = std::min(lo, samples[i]);
+            hi = std::max(hi, samples[i]);
+        }
+    }
+
+#if defined(SWV_X86)
+    void minMaxRangeSse2(const float *samples, size_t count, float &outMin, float &outMax)
+    {
+        float lo = samples[0];
+        float hi = samples[0];
+        size_t i = 1;
+        if (count >= 8)
+        {
+            __m128 vlo = _mm_loadu_ps(samples);
+            __m128 vhi = vlo;
+            for (i = 4; i + 4 <= count; i += 4)
+            {
+                __m128 v = _mm_loadu_ps(samples + i);
+                vlo = _mm_min_ps(vlo, v);
+                vhi = _mm_max_ps(vhi, v);
+            }
+            float l[4], h[4];
+            _mm_storeu_ps(l, vlo);
+            _mm_storeu_ps(h, vhi);
+            lo = std::min(std::min(l[0], l[1]), std::min(l[2], l[3]));
+            hi = std::max(std::max(h[0], h[1]), std::max(h[2], h[3]));
+        }
+        minMaxScalar(samples, i, count, lo, hi);
+        outMin = lo;
+        outMax = hi;
+    }
+
+    SWV_TARGET_AVX void minMaxRangeAvx(const float *samples, size_t count, float &outMin, float &outMax)
+    {
+        float lo = samples[0];
+        float hi = samples[0];
+        size_t i = 1;
+        if (count >= 16)
+        {
+            __m256 vlo = _mm256_loadu_ps(samples);
+            __m256 vhi = vlo;
+            for (i = 8; i + 8 <= count; i += 8)
+            {
+                __m256 v = _mm256_loadu_ps(samples + i);
+                vlo = _mm256_min_ps(vlo, v);
+                vhi = _mm256_max_ps(vhi, v);
+            }
+            __m128 lo4 = _mm_min_ps(_mm256_castps256_ps128(vlo), _mm256_extractf128_ps(vlo, 1));
+            __m128 hi4 = _mm_max_ps(_mm256_castps256_ps128(vhi), _mm256_extractf128_ps(vhi, 1));
+            float l[4], h[4];
+            _mm_storeu_ps(l, lo4);
+            _mm_storeu_ps(h, hi4);
+            lo = std::min(std::min(l[0], l[1]), std::min(l[2], l[3]));
+            hi = std::max(std::max(h[0], h[1]), std::max(h[2], h[3]));
+        }
+        minMaxScalar(samples, i, count, lo, hi);
+        outMin = lo;
+        outMax = hi;
+    }
+#else
+    void minMaxRangePortable(const float *samples, size_t count, float &outMin, float &outMax)
+    {
+        float lo = samples[0];
+        float hi = samples[0];
+        minMaxScalar(samples, 1, count, lo, hi);
+        outMin = lo;
+        outMax = hi;
+    }
+#endif
+
+    MinMaxFn minMaxRange()
+    {
+#if defined(SWV_X86)
+        static const MinMaxFn selected = cpuHasAvx() ? minMaxRangeAvx : minMaxRangeSse2;
+#else
+        static const MinMaxFn selected = minMaxRangePortable;
+#endif
+        return selected;
+    }
+}
+
+void decimateMinMax(const float *samples, size_t count, size_t columns, float *outMin, float *outMax)
+{
+    if (columns == 0)
+        return;
+    if (count == 0)
+    {
+        std::fill(outMin, outMin + columns, 0.0f);
+        std::fill(outMax, outMax + columns, 0.0f);
+        return;
+    }
+
+    const MinMaxFn range = minMaxRange();
+    for (size_t c = 0; c < columns; ++c)
+    {
+        size_t begin = c * count / columns;
+        size_t end = (c + 1) * count / columns;
+        if (end <= begin)
+        {
+            // Fewer samples than columns
+            float sample = samples[std::min(begin, count - 1)];
+            outMin[c] = sample;
+            outMax[c] = sample;
+            continue;
+        }
+        range(samples + begin, end - begin, outMin[c], outMax[c]);
+    }
+}
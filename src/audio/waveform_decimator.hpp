@@ -0,0 +1,9 @@
+#pragma once
+#include <cstddef>
+
+// Reduces `count` samples to `columns` min/max pairs, one per output column
+// (typically one per pixel). Column c covers samples
+// [c * count / columns, (c + 1) * count / columns); when there are fewer
+// samples than columns, each column takes its nearest sample. Uses AVX min/max
+// when the CPU supports it, SSE2 otherwise.
+void decimateMinMax(const float *samples, size_t count, size_t columns, float *outMin, float *outMax);
@@ -0,0 +1,132 @@
+#include "config.hpp"
+#include <fstream>
+#include <iostream>
+#include "nlohmann/json.hpp"
+
+using json = nlohmann::json;
+
+namespace
+{
+    // Beyond these the pipeline breaks rather than degrades: a window longer
+    // than the rolling history never fills, and bar counts must be positive
+    constexpr int MIN_FFT_SIZE = 64;
+    constexpr int MAX_FFT_SIZE = 16384; // Fits the 4 s history down to ~4 kHz
+    constexpr int MIN_BAR_COUNT = 1;
+    constexpr int MAX_BAR_COUNT = 8192;
+    constexpr float MIN_WAVE_SECONDS = 0.01f;
+    constexpr float MAX_WAVE_SECONDS = 10.0f;
+    constexpr long long MAX_WINDOW_SIZE = 16384;
+
+    // Out-of-range values are pulled back into [lo, hi] with a warning
+    template <typename T>
+    T clampSetting(const char *key, T value, T lo, T hi)
+    {
+        if (value >= lo && value <= hi)
+            return value;
+        T clamped = value < lo ? lo : hi;
+        std::cerr << "[WARN] " << key << " " << value << " is out of range [" << lo << ", " << hi
+                  << "], using " << clamped << "." << std::endl;
+        return clamped;
+    }
+
+    // A window dimension of zero (or a negative one, which would wrap around
+    // as unsigned) is rejected outright and the default kept
+    unsigned int windowSize(const char *key, long long value, unsigned int fallback)
+    {
+        if (value >= 1 && value <= MAX_WINDOW_SIZE)
+            return static_cast<unsigned int>(value);
+        std::cerr << "[WARN] " << key << " " << value << " is out of range [1, " << MAX_WINDOW_SIZE
+                  << "], keeping " << fallback << "." << std::endl;
+        return fallback;
+    }
+
+    // Colors are written as [r, g, b] or [r, g, b, a]
+    bool parseColor(const json &value, sf::Color &color)
+    {
+        if (!value.is_array() || value.size() < 3 || value.size() > 4)
+            return false;
+        for (const auto &channel : value)
+        {
+            if (!channel.is_number())
+                return false;
+        }
+
+        color.r = static_cast<std::uint8_t>(value[0].get<int>());
+        color.g = static_cast<std::uint8_t>(value[1].get<int>());
+        color.b = static_cast<std::uint8_t>(value[2].get<int>());
+        color.a = value.size() == 4 ? static_cast<std::uint8_t>(value[3].get<int>()) : 255;
+        return true;
+    }
+
+    // "gradient": [ { "position": 0.0, "color": [0, 255, 255, 200] }, ... ]
+    std::vector<GradientStop> parseGradient(const json &value)
+    {
+        std::vector<GradientStop> stops;
+        if (!value.is_array())
+            return stops;
+
+        for (const auto &entry : value)
+        {
+            GradientStop stop;
+            if (!entry.is_object() || !parseColor(entry.value("color", json()), stop.color))
+            {
+                std::cerr << "[WARN] Ignoring malformed gradient stop in config." << std::endl;
+                continue;
+            }
+            stop.position = entry.value("position", 0.0f);
+            stops.push_back(stop);
+        }
+        return stops;
+    }
+}
+
+Config Config::load(const std::string &path)
+{
+    Config config;
+
+    std::ifstream file(path);
+    if (!file)
+    {
+        std::cerr << "[WARN] " << path << " not found, using defaults." << std::endl;
+        return config;
+    }
+
+    json root = json::parse(file, nullptr, false);
+    if (root.is_discarded() || !root.is_object())
+    {
+        std::cerr << "[WARN] " << path << " is not valid JSON, using defaults." << std::endl;
+        return config;
+    }
+
+    try
+    {
+        const json window = root.value("window", json::object());
+        config.window.width = windowSize("width", window.value("width", (long long)config.window.width),
+                                         config.window.width);
+        config.window.height = windowSize("height", window.value("height", (long long)config.window.height),
+                                          config.window.height);
+        config.window.positionX = window.value("position_x", config.window.positionX);
+        config.window.positionY = window.value("position_y", config.window.positionY);
+        config.window.alwaysOnTop = window.value("always_on_top", config.window.alwaysOnTop);
+
+        const json audio = root.value("audio", json::object());
+        config.audio.fftSize = clampSetting("fft_size", audio.value("fft_size", config.audio.fftSize),
+                                            MIN_FFT_SIZE, MAX_FFT_SIZE);
+
+        const json visualizer = root.value("visualizer", json::object());
+        config.visualizer.mode = visualizer.value("mode", config.visualizer.mode);
+        config.visualizer.barCount = clampSetting("bar_count", visualizer.value("bar_count", config.visualizer.barCount),
+                                                  MIN_BAR_COUNT, MAX_BAR_COUNT);
+        config.visualizer.waveSeconds = clampSetting("wave_seconds", visualizer.value("wave_seconds", config.visualizer.waveSeconds),
+                                                     MIN_WAVE_SECONDS, MAX_WAVE_SECONDS);
+        config.visualizer.waveTrigger = visualizer.value("wave_trigger", config.visualizer.waveTrigger);
+        config.visualizer.gradient = parseGradient(visualizer.value("gradient", json()));
+    }
+    catch (const json::exception &e)
+    {
+        // Wrong value types; keep whatever parsed before the bad key
+        std::cerr << "[WARN] Invalid value in " << path << ": " << e.what() << std::endl;
+    }
+
+    return config;
+}
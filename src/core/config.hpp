@@ -0,0 +1,35 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "visualizer/color_gradient.hpp"
+
+// Application settings from config.json. Keys missing from the file keep the
+// defaults below.
+struct Config
+{
+    struct Window
+    {
+        unsigned int width = 800;  // 1..16384
+        unsigned int height = 200; // 1..16384
+        int positionX = -1; // -1 = centered
+        int positionY = -1; // -1 = just above the taskbar
+        bool alwaysOnTop = true;
+    } window;
+
+    struct Audio
+    {
+        int fftSize = 1024; // 64..16384 samples
+    } audio;
+
+    struct Visualizer
+    {
+        std::string mode = "bars"; // Registered visualizer name
+        int barCount = 64; // 1..8192
+        float waveSeconds = 2.0f; // Span shown by the waveform view, 0.01..10
+        bool waveTrigger = false; // Start the waveform on a rising edge
+        std::vector<GradientStop> gradient; // Empty = built-in gradient
+    } visualizer;
+
+    // Falls back to defaults (with a warning) if the file is missing or malformed
+    static Config load(const std::string &path);
+};
@@ -0,0 +1,88 @@
+#include "latency_histogram.hpp"
+#include <algorithm>
+#include <iomanip>
+#include "audio/analysis_frame.hpp"
+
+namespace
+{
+    constexpr double BIN_SECONDS = 0.0001; // 0.1 ms
+    constexpr size_t BIN_COUNT = 10000;    // Up to 1 s
+}
+
+LatencyHistogram::LatencyHistogram()
+    : m_bins(BIN_COUNT, 0)
+{
+}
+
+void LatencyHistogram::add(double seconds)
+{
+    seconds = std::max(seconds, 0.0);
+    size_t bin = std::min((size_t)(seconds / BIN_SECONDS), BIN_COUNT - 1);
+    m_bins[bin]++;
+    m_count++;
+    m_max = std::max(m_max, seconds);
+}
+
+void LatencyHistogram::reset()
+{
+    std::fill(m_bins.begin(), m_bins.end(), 0);
+    m_count = 0;
+    m_max = 0.0;
+}
+
+double LatencyHistogram::percentile(double p) const
+{
+    if (m_count == 0)
+        return 0.0;
+
+    // Smallest bin whose cumulative count reaches the rank
+    uint64_t rank = std::max<uint64_t>(1, (uint64_t)(std::clamp(p, 0.0, 1.0) * m_count + 0.5));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < m_bins.size(); i++)
+    {
+        seen += m_bins[i];
+        if (seen >= rank)
+            return std::min((i + 1) * BIN_SECONDS, m_max);
+    }
+    return m_max;
+}
+
+void LatencyHistogram::print(std::ostream &out, const char *name) const
+{
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << "  " << std::left << std::setw(22) << name << std::right << std::fixed << std::setprecision(1)
+        << "p50 " << std::setw(6) << percentile(0.5) * 1000.0 << " ms   "
+        << "p99 " << std::setw(6) << percentile(0.99) * 1000.0 << " ms   "
+        << "max " << std::setw(6) << m_max * 1000.0 << " ms" << std::endl;
+    out.flags(flags);
+    out.precision(precision);
+}
+
+bool PipelineLatency::record(const AnalysisFrame &frame, Clock::time_point presentedAt)
+{
+    if (frame.sequence == m_lastSequence || frame.capturedAt == Clock::time_point{})
+        return false;
+    m_lastSequence = frame.sequence;
+
+    using Seconds = std::chrono::duration<double>;
+    m_analysis.add(Seconds(frame.publishedAt - frame.capturedAt).count());
+    m_render.add(Seconds(presentedAt - frame.publishedAt).count());
+    m_total.add(Seconds(presentedAt - frame.capturedAt).count());
+    return true;
+}
+
+void PipelineLatency::report(std::ostream &out) const
+{
+    out << "[INFO] Latency over " << m_total.count() << " frames:" << std::endl;
+    m_analysis.print(out, "capture -> analysis");
+    m_render.print(out, "analysis -> present");
+    m_total.print(out, "capture -> present");
+}
+
+void PipelineLatency::reset()
+{
+    m_analysis.reset();
+    m_render.reset();
+    m_total.reset();
+}
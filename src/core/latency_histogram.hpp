@@ -0,0 +1,59 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+struct AnalysisFrame;
+
+// Fixed-resolution histogram of latencies: 0.1 ms bins up to one second,
+// anything slower lands in the last bin. Adding is O(1) and never allocates,
+// so it can run every frame.
+class LatencyHistogram
+{
+public:
+    LatencyHistogram();
+
+    void add(double seconds);
+    void reset();
+
+    uint64_t count() const { return m_count; }
+    double max() const { return m_max; }
+
+    // Upper edge of the bin holding the p-th fraction (0..1) of samples (at
+    // most max()), in seconds; 0 when empty
+    double percentile(double p) const;
+
+    // "<name>  p50 .. ms   p99 .. ms   max .. ms" on one line
+    void print(std::ostream &out, const char *name) const;
+
+private:
+    std::vector<uint32_t> m_bins;
+    uint64_t m_count = 0;
+    double m_max = 0.0;
+};
+
+// Per-stage latency of the frames actually shown: capture -> analysis
+// published -> presented. Each analysis frame counts once, at the first
+// present that shows it.
+class PipelineLatency
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Call right after presenting a frame drawn from `frame`. Returns true if
+    // it was recorded (a new frame with a known capture time).
+    bool record(const AnalysisFrame &frame, Clock::time_point presentedAt);
+
+    // One line per stage: p50 / p99 / max in milliseconds
+    void report(std::ostream &out) const;
+    void reset();
+
+    const LatencyHistogram &total() const { return m_total; }
+
+private:
+    LatencyHistogram m_analysis; // Capture -> published
+    LatencyHistogram m_render;   // Published -> presented
+    LatencyHistogram m_total;    // Capture -> presented
+    uint64_t m_lastSequence = 0;
+};
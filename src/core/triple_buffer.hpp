@@ -0,0 +1,49 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// Lock-free triple buffer for handing the newest value from one writer thread
+// to one reader thread.
+//
+// The writer fills writeBuffer() and calls publish(); the reader calls update()
+// and then reads readBuffer(). Neither side ever waits: the writer always has a
+// free slot, and the reader simply skips any values published in between.
+template <typename T>
+class TripleBuffer
+{
+public:
+    // Writer side
+    T &writeBuffer() { return m_slots[m_back]; }
+
+    void publish()
+    {
+        uint8_t previous = m_middle.exchange(m_back | DIRTY, std::memory_order_acq_rel);
+        m_back = previous & INDEX_MASK;
+    }
+
+    // Reader side. Returns true if a newer value was swapped into readBuffer().
+    bool update()
+    {
+        if ((m_middle.load(std::memory_order_relaxed) & DIRTY) == 0)
+            return false;
+
+        uint8_t previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+        m_front = previous & INDEX_MASK;
+        return true;
+    }
+
+    const T &readBuffer() const { return m_slots[m_front]; }
+
+    // The reader owns this slot until its next update(), so it may fill in
+    // parts of the value the writer never touches
+    T &readBuffer() { return m_slots[m_front]; }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t DIRTY = 0x4; // Set on the middle slot when it holds unread data
+
+    T m_slots[3];
+    uint8_t m_back = 0; // Writer only
+    alignas(64) std::atomic<uint8_t> m_middle{1};
+    alignas(64) uint8_t m_front = 2; // Reader only
+};
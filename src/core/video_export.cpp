@@ -0,0 +1,378 @@
+#include "video_export.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "core/config.hpp"
+#include "audio/analysis_products.hpp"
+#include "audio/fft_processor.hpp"
+#include "audio/file_source.hpp"
+#include "render/software_surface.hpp"
+#include "visualizer/visualizer_registry.hpp"
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SWV_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    constexpr size_t WRITE_BUFFER = 1 << 22;                // stdio buffer for the video stream
+    constexpr auto DECODE_WAIT = std::chrono::milliseconds(1); // Back-off while the decoder catches up
+    constexpr float SYNTHETIC_SECONDS = 10.0f;              // Length of an endless synthetic signal
+    const sf::Color BACKGROUND_COLOR(15, 15, 25, 255);      // Opaque version of the window background
+
+#if defined(SWV_SSE2)
+    // Splits 8 RGBA pixels into 16-bit R, G and B lanes
+    inline void splitChannels(const std::uint8_t *rgba, __m128i &r, __m128i &g, __m128i &b)
+    {
+        const __m128i low = _mm_set1_epi32(0xFF);
+        __m128i p0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rgba));
+        __m128i p1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rgba + 16));
+        r = _mm_packs_epi32(_mm_and_si128(p0, low), _mm_and_si128(p1, low));
+        g = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(p0, 8), low), _mm_and_si128(_mm_srli_epi32(p1, 8), low));
+        b = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(p0, 16), low), _mm_and_si128(_mm_srli_epi32(p1, 16), low));
+    }
+
+    // 8 luma values; the true sum stays below 2^16, so unsigned wraparound
+    // in the 16-bit lanes is harmless
+    inline __m128i lumaOf(__m128i r, __m128i g, __m128i b)
+    {
+        __m128i sum = _mm_add_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(77)), _mm_mullo_epi16(g, _mm_set1_epi16(150)));
+        sum = _mm_add_epi16(_mm_add_epi16(sum, _mm_mullo_epi16(b, _mm_set1_epi16(29))), _mm_set1_epi16(128));
+        return _mm_srli_epi16(sum, 8);
+    }
+
+    // Average of each 2x2 block, from the 16-bit lanes of two rows: 4 x int32
+    inline __m128i blockAverage(__m128i top, __m128i bottom)
+    {
+        __m128i pairs = _mm_madd_epi16(_mm_add_epi16(top, bottom), _mm_set1_epi16(1));
+        return _mm_srai_epi32(_mm_add_epi32(pairs, _mm_set1_epi32(2)), 2);
+    }
+
+    // One chroma plane for 4 blocks: (cr*r + cg*g + cb*b + 32896) >> 8
+    inline void storeChroma(__m128i r, __m128i g, __m128i b, short cr, short cg, short cb, std::uint8_t *out)
+    {
+        __m128i rg = _mm_unpacklo_epi16(_mm_packs_epi32(r, r), _mm_packs_epi32(g, g));
+        __m128i b0 = _mm_unpacklo_epi16(_mm_packs_epi32(b, b), _mm_setzero_si128());
+        __m128i sum = _mm_add_epi32(_mm_madd_epi16(rg, _mm_setr_epi16(cr, cg, cr, cg, cr, cg, cr, cg)),
+                                    _mm_madd_epi16(b0, _mm_setr_epi16(cb, 0, cb, 0, cb, 0, cb, 0)));
+        sum = _mm_srai_epi32(_mm_add_epi32(sum, _mm_set1_epi32(32768 + 128)), 8);
+        __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(sum, sum), _mm_setzero_si128());
+        int packed = _mm_cvtsi128_si32(bytes);
+        std::memcpy(out, &packed, 4);
+    }
+
+    // Converts 8-pixel groups of a row pair; returns how many columns it did
+    unsigned int convertRowPair(const std::uint8_t *row0, const std::uint8_t *row1, unsigned int width,
+                                std::uint8_t *y0, std::uint8_t *y1, std::uint8_t *u, std::uint8_t *v)
+    {
+        unsigned int x = 0;
+        for (; x + 8 <= width; x += 8)
+        {
+            __m128i r0, g0, b0, r1, g1, b1;
+            splitChannels(row0 + x * 4, r0, g0, b0);
+            splitChannels(row1 + x * 4, r1, g1, b1);
+
+            __m128i luma = _mm_packus_epi16(lumaOf(r0, g0, b0), lumaOf(r1, g1, b1));
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(y0 + x), luma);
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(y1 + x), _mm_srli_si128(luma, 8));
+
+            __m128i r = blockAverage(r0, r1), g = blockAverage(g0, g1), b = blockAverage(b0, b1);
+            storeChroma(r, g, b, -43, -85, 128, u + x / 2);
+            storeChroma(r, g, b, 128, -107, -21, v + x / 2);
+        }
+        return x;
+    }
+#endif
+
+    class FrameWriter
+    {
+    public:
+        FrameWriter(std::FILE *file, VideoFormat format, unsigned int width, unsigned int height)
+            : m_file(file), m_format(format), m_width(width), m_height(height)
+        {
+            if (format == VideoFormat::Y4m)
+                m_yuv.resize(static_cast<size_t>(width) * height * 3 / 2);
+        }
+
+        bool writeHeader(unsigned int fps)
+        {
+            if (m_format != VideoFormat::Y4m)
+                return true;
+            return std::fprintf(m_file, "YUV4MPEG2 W%u H%u F%u:1 Ip A1:1 C420jpeg\n", m_width, m_height, fps) > 0;
+        }
+
+        bool write(const std::uint8_t *rgba)
+        {
+            if (m_format == VideoFormat::Rgba)
+            {
+                size_t bytes = static_cast<size_t>(m_width) * m_height * 4;
+                return std::fwrite(rgba, 1, bytes, m_file) == bytes;
+            }
+
+            convertToYuv420(rgba);
+            return std::fputs("FRAME\n", m_file) >= 0 &&
+                   std::fwrite(m_yuv.data(), 1, m_yuv.size(), m_file) == m_yuv.size();
+        }
+
+    private:
+        std::FILE *m_file;
+        VideoFormat m_format;
+        unsigned int m_width;
+        unsigned int m_height;
+        std::vector<std::uint8_t> m_yuv;
+
+        // BT.601 full range in 8.8 fixed point. Luma per pixel, chroma from the
+        // average of each 2x2 block. Offsets keep every intermediate positive.
+        void convertToYuv420(const std::uint8_t *rgba)
+        {
+            const size_t stride = static_cast<size_t>(m_width) * 4;
+            std::uint8_t *yPlane = m_yuv.data();
+            std::uint8_t *uPlane = yPlane + static_cast<size_t>(m_width) * m_height;
+            std::uint8_t *vPlane = uPlane + static_cast<size_t>(m_width / 2) * (m_height / 2);
+
+            for (unsigned int y = 0; y < m_height; y += 2)
+            {
+                const std::uint8_t *row0 = rgba + y * stride;
+                const std::uint8_t *row1 = row0 + stride;
+                std::uint8_t *y0 = yPlane + static_cast<size_t>(y) * m_width;
+                std::uint8_t *y1 = y0 + m_width;
+                std::uint8_t *uRow = uPlane + static_cast<size_t>(y / 2) * (m_width / 2);
+                std::uint8_t *vRow = vPlane + static_cast<size_t>(y / 2) * (m_width / 2);
+
+                unsigned int x = 0;
+#if defined(SWV_SSE2)
+                x = convertRowPair(row0, row1, m_width, y0, y1, uRow, vRow);
+#endif
+                for (; x < m_width; x += 2)
+                {
+                    // Read the 2x2 block into locals first: stores to the
+                    // planes could otherwise alias the source bytes
+                    const std::uint8_t *a = row0 + x * 4;
+                    const std::uint8_t *c = row1 + x * 4;
+                    const int r0 = a[0], g0 = a[1], b0 = a[2], r1 = a[4], g1 = a[5], b1 = a[6];
+                    const int r2 = c[0], g2 = c[1], b2 = c[2], r3 = c[4], g3 = c[5], b3 = c[6];
+
+                    y0[x] = luma(r0, g0, b0);
+                    y0[x + 1] = luma(r1, g1, b1);
+                    y1[x] = luma(r2, g2, b2);
+                    y1[x + 1] = luma(r3, g3, b3);
+
+                    const int r = (r0 + r1 + r2 + r3 + 2) >> 2;
+                    const int g = (g0 + g1 + g2 + g3 + 2) >> 2;
+                    const int bl = (b0 + b1 + b2 + b3 + 2) >> 2;
+                    uRow[x / 2] = static_cast<std::uint8_t>(std::min(255, (-43 * r - 85 * g + 128 * bl + 32768 + 128) >> 8));
+                    vRow[x / 2] = static_cast<std::uint8_t>(std::min(255, (128 * r - 107 * g - 21 * bl + 32768 + 128) >> 8));
+                }
+            }
+        }
+
+        static std::uint8_t luma(int r, int g, int b)
+        {
+            return static_cast<std::uint8_t>((77 * r + 150 * g + 29 * b + 128) >> 8);
+        }
+    };
+
+    bool parseUnsigned(const char *text, unsigned int &out)
+    {
+        char *end = nullptr;
+        unsigned long value = std::strtoul(text, &end, 10);
+        if (end == text || *end != '\0' || value == 0)
+            return false;
+        out = static_cast<unsigned int>(value);
+        return true;
+    }
+}
+
+bool parseExportOptions(int argc, char **argv, ExportOptions &options)
+{
+    bool synthetic = false;
+    if (!parseSignalOptions(argc, argv, options.signal, synthetic))
+        return false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string flag = argv[i];
+        if (flag != "--export" && flag != "--out" && flag != "--fps" && flag != "--size" && flag != "--format" && flag != "--mode")
+            continue;
+
+        if (i + 1 >= argc)
+        {
+            std::cerr << "[ERROR] " << flag << " needs a value" << std::endl;
+            return false;
+        }
+        std::string value = argv[++i];
+
+        bool ok = true;
+        if (flag == "--export")
+            options.input = value;
+        else if (flag == "--out")
+            options.output = value;
+        else if (flag == "--fps")
+            ok = parseUnsigned(value.c_str(), options.fps);
+        else if (flag == "--mode")
+            options.mode = value;
+        else if (flag == "--format")
+        {
+            ok = value == "y4m" || value == "rgba";
+            options.format = value == "rgba" ? VideoFormat::Rgba : VideoFormat::Y4m;
+        }
+        else if (flag == "--size")
+        {
+            size_t x = value.find('x');
+            ok = x != std::string::npos &&
+                 parseUnsigned(value.substr(0, x).c_str(), options.width) &&
+                 parseUnsigned(value.substr(x + 1).c_str(), options.height);
+        }
+
+        if (!ok)
+        {
+            std::cerr << "[ERROR] Invalid value for " << flag << ": '" << value << "'" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int exportVideo(const ExportOptions &options, const Config &config)
+{
+    const unsigned int width = options.width ? options.width : config.window.width;
+    const unsigned int height = options.height ? options.height : config.window.height;
+    if (options.format == VideoFormat::Y4m && (width % 2 || height % 2))
+    {
+        std::cerr << "[ERROR] Y4M output needs an even frame size, got " << width << "x" << height << std::endl;
+        return 1;
+    }
+
+    // Decoded (or generated) on its own thread, at most a ring ahead of the
+    // frame being rendered. The history covers the trigger search plus waveform span,
+    // with room to spare.
+    const float historySeconds = std::max(4.0f, config.visualizer.waveSeconds * 2.0f + 1.0f);
+    std::unique_ptr<AudioSource> input;
+    if (options.input == "synthetic")
+    {
+        SignalSpec signal = options.signal;
+        if (signal.seconds <= 0.0f)
+            signal.seconds = SYNTHETIC_SECONDS;
+        input = std::make_unique<SyntheticSource>(signal, SourcePacing::AsFastAsPossible, historySeconds);
+    }
+    else
+    {
+        input = std::make_unique<FileSource>(options.input, SourcePacing::AsFastAsPossible, historySeconds);
+    }
+    if (!input->init())
+        return 1;
+    AudioSource &source = *input;
+    const unsigned int sampleRate = source.sampleRate();
+
+    VisualizerRegistry registry = VisualizerRegistry::withBuiltins();
+    VisualizerContext context{(float)width, (float)height, sampleRate, config};
+    std::string mode = options.mode.empty() ? config.visualizer.mode : options.mode;
+    std::unique_ptr<VisualizerBase> visualizer = registry.create(mode, context);
+    if (!visualizer)
+    {
+        std::cerr << "[ERROR] Unknown visualizer mode '" << mode << "'" << std::endl;
+        return 1;
+    }
+    const AnalysisRequirements requirements = visualizer->requirements();
+
+    std::FILE *file = stdout;
+    if (options.output != "-")
+        file = std::fopen(options.output.c_str(), "wb");
+    if (file == nullptr)
+    {
+        std::cerr << "[ERROR] Failed to open '" << options.output << "' for writing" << std::endl;
+        return 1;
+    }
+#ifdef _WIN32
+    if (file == stdout)
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+    std::setvbuf(file, nullptr, _IOFBF, WRITE_BUFFER);
+
+    FftProcessor fft(config.audio.fftSize);
+    SoftwareSurface surface(width, height);
+    FrameWriter writer(file, options.format, width, height);
+    bool ok = writer.writeHeader(options.fps);
+
+    AnalysisFrame frame;
+    frame.products = requirements.products;
+    if (requirements.products & ANALYSIS_SPECTRUM)
+        frame.bins.assign(fft.size() / 2 + 1, 0.0f);
+    const float dt = 1.0f / options.fps;
+    uint64_t previousEnd = 0;
+    uint64_t frames = 0;
+    auto started = std::chrono::steady_clock::now();
+
+    while (ok)
+    {
+        // Frame k shows the audio up to the end of its own frame interval.
+        // Drain no further than that: the rest stays in the rings, whose
+        // backpressure keeps the decoder from running away from the frames.
+        uint64_t end = (frames + 1) * sampleRate / options.fps;
+        const AudioHistory &history = source.drainHistoryUpTo(end);
+        while (history.sequence() < end && !source.finished())
+        {
+            std::this_thread::sleep_for(DECODE_WAIT);
+            source.drainHistoryUpTo(end);
+        }
+
+        end = std::min(end, history.sequence());
+        if (end <= previousEnd)
+            break; // Out of audio
+
+        frame.sequence = end;
+        frame.time = end / (double)sampleRate;
+
+        if (requirements.products & ANALYSIS_SPECTRUM)
+        {
+            // The hops that completed within this frame's interval, as the
+            // live pipeline delivers them. Until the first full window bins
+            // stay silent, which keeps the start of the clip deterministic.
+            frame.hopSpectra.clear();
+            frame.hopSequences.clear();
+            fft.processHops(history, [&](const std::vector<float> &bins, uint64_t hopEnd)
+            {
+                frame.hopSpectra.insert(frame.hopSpectra.end(), bins.begin(), bins.end());
+                frame.hopSequences.push_back(hopEnd);
+            });
+            foldHops(frame);
+        }
+        if (requirements.products & ANALYSIS_WAVEFORM)
+            fillWaveform(history, sampleRate, requirements, frame);
+        if (requirements.products & ANALYSIS_STEREO)
+            fillStereo(source.channel(0), source.channel(1), requirements.stereoMaxPairs, frame);
+        previousEnd = end;
+
+        visualizer->update(frame, dt);
+        surface.clear(BACKGROUND_COLOR);
+        visualizer->draw(surface);
+        ok = writer.write(surface.pixels());
+        ++frames;
+    }
+
+    ok = std::fflush(file) == 0 && ok;
+    if (file != stdout)
+        ok = std::fclose(file) == 0 && ok;
+
+    if (!ok)
+    {
+        std::cerr << "[ERROR] Failed writing video to '" << options.output << "'" << std::endl;
+        return 1;
+    }
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    double audioSeconds = previousEnd / (double)sampleRate;
+    std::cerr << "[INFO] Exported " << frames << " frames (" << audioSeconds << " s of audio) in "
+              << elapsed << " s, " << (elapsed > 0.0 ? audioSeconds / elapsed : 0.0) << "x realtime." << std::endl;
+    return 0;
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <string>
+#include "audio/synthetic_source.hpp"
+
+struct Config;
+
+enum class VideoFormat
+{
+    Rgba, // Raw RGBA8 frames back to back, no header
+    Y4m,  // YUV4MPEG2, 4:2:0 full range; ffmpeg and most players read it
+};
+
+struct ExportOptions
+{
+    std::string input;          // Audio file or "synthetic"; empty = no export requested
+    SignalSpec signal;          // Rendered when input is "synthetic"
+    std::string output = "-";   // File path, or "-" for stdout
+    unsigned int fps = 60;
+    unsigned int width = 0;     // 0 = config window size
+    unsigned int height = 0;
+    VideoFormat format = VideoFormat::Y4m;
+    std::string mode;           // Visualizer name; empty = config mode
+};
+
+// Reads --export <audio|synthetic> [--out <path|->] [--fps N] [--size WxH]
+// [--format y4m|rgba] [--mode <name>], plus the --synthetic signal flags.
+// Leaves options.input empty when --export isn't given; returns false after
+// printing why on bad flags.
+bool parseExportOptions(int argc, char **argv, ExportOptions &options);
+
+// Decodes the file (or generates the signal) and renders it headlessly at a fixed virtual frame rate:
+// every frame analyzes exactly the audio up to its own timestamp, so output
+// is deterministic and runs as fast as the CPU allows. Returns the process
+// exit code.
+int exportVideo(const ExportOptions &options, const Config &config);
@@ -1,8 +1,10 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/Window.hpp>
 #include <SFML/Window/WindowHandle.hpp>
+#ifdef _WIN32
 #include <Windows.h>
 #include <dwmapi.h>
+#endif
 #include <iostream>
 #include <optional>
 #include <vector>
@@ -15,15 +17,28 @@
 #include "miniaudio.h"
 // ==========================================
 
+#include "core/config.hpp"
+#include "core/latency_histogram.hpp"
+#include "core/video_export.hpp"
+
 // Audio & Processing
+#include "audio/analysis_thread.hpp"
 #include "audio/audio_capture.hpp"
-#include "audio/fft_processor.hpp"
+#include "audio/file_source.hpp"
+#include "audio/synthetic_source.hpp"
 
 // Visualizer
-#include "visualizer/bar_visualizer.hpp"
+#include "render/sfml_surface.hpp"
+#include "visualizer/visualizer_registry.hpp"
 
 using namespace std;
 
+constexpr float LATENCY_REPORT_SECONDS = 5.0f; // --latency prints and restarts its histograms this often
+
+#ifdef _WIN32
+// Magenta is the layered window's color key: anything cleared to it is see-through
+const sf::Color CLEAR_COLOR(255, 0, 255);
+
 // --- Transparency Helper ---
 void makeWindowTransparent(sf::RenderWindow &window)
 {
@@ -51,13 +66,32 @@ void setAlwaysOnTop(sf::RenderWindow &window)
     HWND hwnd = static_cast<HWND>(window.getNativeHandle());
     SetWindowPos(hwnd, HWND_TOPMOST, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE | SWP_NOACTIVATE);
 }
+#else
+// No color-key transparency outside Windows; the window is simply opaque
+const sf::Color CLEAR_COLOR(0, 0, 0);
+
+void makeWindowTransparent(sf::RenderWindow &) {}
+void setAlwaysOnTop(sf::RenderWindow &) {}
+#endif
 
 // --- Main ---
-int main()
+int main(int argc, char **argv)
 {
-    constexpr unsigned int WINDOW_WIDTH = 800;
-    constexpr unsigned int WINDOW_HEIGHT = 200;
-    constexpr int NUM_BARS = 64;
+    Config config = Config::load("config.json");
+
+    // Offline rendering to a video stream: no window, no capture device
+    ExportOptions exportOptions;
+    if (!parseExportOptions(argc, argv, exportOptions))
+        return 1;
+    if (!exportOptions.input.empty())
+        return exportVideo(exportOptions, config);
+
+    // --latency: live capture-to-present report
+    bool reportLatency = false;
+    for (int i = 1; i < argc; ++i)
+        reportLatency = reportLatency || std::string(argv[i]) == "--latency";
+    const unsigned int WINDOW_WIDTH = config.window.width;
+    const unsigned int WINDOW_HEIGHT = config.window.height;
 
     // Create Window
     sf::RenderWindow window(
@@ -68,28 +102,77 @@ int main()
 
     // Position Window
     sf::VideoMode desktop = sf::VideoMode::getDesktopMode();
-    window.setPosition({(int)(desktop.size.x - WINDOW_WIDTH) / 2,
-                        (int)(desktop.size.y - WINDOW_HEIGHT - 60)});
+    int posX = config.window.positionX >= 0 ? config.window.positionX : (int)(desktop.size.x - WINDOW_WIDTH) / 2;
+    int posY = config.window.positionY >= 0 ? config.window.positionY : (int)(desktop.size.y - WINDOW_HEIGHT - 60);
+    window.setPosition({posX, posY});
 
     // Apply Transparency Fixes
     makeWindowTransparent(window);
-    setAlwaysOnTop(window);
+    if (config.window.alwaysOnTop)
+        setAlwaysOnTop(window);
+
+    // Init Audio: system loopback, a file played in real time (--play <file>)
+    // or a generated test signal (--synthetic <kind>)
+    std::string playPath;
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (std::string(argv[i]) == "--play")
+            playPath = argv[i + 1];
+    }
+    SignalSpec signal;
+    bool synthetic = false;
+    parseSignalOptions(argc, argv, signal, synthetic); // Already validated with the export flags
 
-    // Init Audio
-    AudioCapture audioCapture;
-    if (!audioCapture.init())
+    std::unique_ptr<AudioSource> audioSource;
+    if (synthetic)
+    {
+        audioSource = std::make_unique<SyntheticSource>(signal, SourcePacing::Realtime);
+        if (!audioSource->init())
+            return 1;
+        std::cout << "[INFO] Generating a synthetic signal (seed " << signal.seed << ")." << std::endl;
+    }
+    else if (!playPath.empty())
     {
-        std::cerr << "[ERROR] Failed to init audio capture!" << std::endl;
+        audioSource = std::make_unique<FileSource>(playPath, SourcePacing::Realtime);
+        if (!audioSource->init())
+            return 1;
+        std::cout << "[INFO] Playing '" << playPath << "' at " << audioSource->sampleRate() << " Hz." << std::endl;
     }
     else
     {
-        std::cout << "[INFO] Audio capture ready." << std::endl;
+        audioSource = std::make_unique<AudioCapture>();
+        if (!audioSource->init())
+        {
+            std::cerr << "[ERROR] Failed to init audio capture!" << std::endl;
+        }
+        else
+        {
+            std::cout << "[INFO] Audio capture ready." << std::endl;
+        }
     }
 
-    // Init Processors
-    FftProcessor fftProcessor(1024);
-    std::vector<float> fftOutput;
-    BarVisualizer visualizer(NUM_BARS, (float)WINDOW_WIDTH, (float)WINDOW_HEIGHT);
+    // Init Processors (analysis runs on its own thread from here on)
+    AnalysisThread analysis(*audioSource, config.audio.fftSize);
+
+    // Visualizer (cycle with Tab). The analysis thread only computes what the
+    // active one asks for.
+    VisualizerRegistry registry = VisualizerRegistry::withBuiltins();
+    VisualizerContext context{(float)WINDOW_WIDTH, (float)WINDOW_HEIGHT, audioSource->sampleRate(), config};
+    std::string mode = config.visualizer.mode;
+    std::unique_ptr<VisualizerBase> visualizer = registry.create(mode, context);
+    if (!visualizer)
+    {
+        std::cerr << "[WARN] Unknown visualizer mode '" << mode << "', using '" << registry.names().front() << "'." << std::endl;
+        mode = registry.names().front();
+        visualizer = registry.create(mode, context);
+    }
+    auto forwardRequirements = [&analysis](const AnalysisRequirements &requirements)
+    {
+        analysis.setRequirements(requirements);
+    };
+    visualizer->setRequirementsListener(forwardRequirements);
+    analysis.setRequirements(visualizer->requirements());
+    analysis.start();
 
     // Background (Toggle with 'B')
     sf::RectangleShape background(sf::Vector2f((float)WINDOW_WIDTH, (float)WINDOW_HEIGHT));
@@ -98,6 +181,10 @@ int main()
     bool isDragging = false;
     sf::Vector2i dragOffset;
     bool showBackground = true;
+    sf::Clock frameClock;
+    SfmlSurface surface(window);
+    PipelineLatency latency;
+    sf::Clock latencyClock;
 
     while (window.isOpen())
     {
@@ -112,6 +199,13 @@ int main()
                     window.close();
                 if (key->code == sf::Keyboard::Key::B)
                     showBackground = !showBackground;
+                if (key->code == sf::Keyboard::Key::Tab)
+                {
+                    mode = registry.next(mode);
+                    visualizer = registry.create(mode, context);
+                    visualizer->setRequirementsListener(forwardRequirements);
+                    analysis.setRequirements(visualizer->requirements());
+                }
             }
 
             if (const auto *mouse = event->getIf<sf::Event::MouseButtonPressed>())
@@ -132,16 +226,14 @@ int main()
         if (isDragging)
             window.setPosition(sf::Mouse::getPosition() - dragOffset);
 
-        // Audio Logic
-        std::vector<float> audioBuffer = audioCapture.getAudioBuffer();
-        if (!audioBuffer.empty())
-            fftProcessor.calculate(audioBuffer, fftOutput);
-
-        visualizer.update(fftOutput);
+        // Audio Logic: pick up the newest spectrum, if the worker published one
+        analysis.poll();
+        float dt = frameClock.restart().asSeconds();
+        visualizer->update(analysis.latest(), dt);
 
         // Render
         // 1. Clear with Magenta (The Key Color) -> This punches the hole in the window
-        window.clear(sf::Color(255, 0, 255));
+        window.clear(CLEAR_COLOR);
 
         // 2. Draw Background (Optional) -> This draws ON TOP of the transparent hole
         if (showBackground)
@@ -149,11 +241,23 @@ int main()
             window.draw(background);
         }
 
-        // 3. Draw Bars
-        visualizer.draw(window);
+        // 3. Draw Visualizer
+        visualizer->draw(surface);
 
         window.display();
+
+        if (reportLatency)
+        {
+            latency.record(analysis.latest(), std::chrono::steady_clock::now());
+            if (latencyClock.getElapsedTime().asSeconds() >= LATENCY_REPORT_SECONDS)
+            {
+                latency.report(std::cout);
+                latency.reset();
+                latencyClock.restart();
+            }
+        }
     }
 
+    analysis.stop();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// RGBA8 image living on a surface, for visualizers that build pixels on the
+// CPU (spectrogram, goniometer). Pixel data is row-major, 4 bytes per pixel.
+class SurfaceImage
+{
+public:
+    virtual ~SurfaceImage() = default;
+
+    virtual sf::Vector2u size() const = 0;
+
+    // Replaces the whole image
+    virtual void update(const std::uint8_t *pixels) = 0;
+
+    // Replaces a `regionSize` block at `dest`; pixels holds just that block
+    virtual void update(const std::uint8_t *pixels, sf::Vector2u regionSize, sf::Vector2u dest) = 0;
+};
+
+// Where visualizers draw. Keeps them independent of the window, so the same
+// code can render through SFML on screen (SfmlSurface) or into a plain CPU
+// framebuffer with no GPU at all (SoftwareSurface).
+//
+// Everything is alpha-blended over what's already there, like SFML's default
+// blend mode.
+class RenderSurface
+{
+public:
+    virtual ~RenderSurface() = default;
+
+    virtual sf::Vector2u size() const = 0;
+
+    virtual void clear(sf::Color color) = 0;
+
+    // Colored geometry in pixel coordinates; vertex colors are interpolated.
+    // Texture coordinates are ignored.
+    virtual void drawVertices(const sf::Vertex *vertices, std::size_t count, sf::PrimitiveType type) = 0;
+
+    // Returns nullptr if the backend can't allocate the image
+    virtual std::unique_ptr<SurfaceImage> createImage(sf::Vector2u size) = 0;
+
+    // Stretches `image` over `dest`. scrollX shifts the source to the right
+    // by that many texels, wrapping around horizontally. The image must come
+    // from this surface's createImage().
+    virtual void drawImage(const SurfaceImage &image, sf::FloatRect dest, float scrollX = 0.0f) = 0;
+};
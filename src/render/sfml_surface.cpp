@@ -0,0 +1,59 @@
+#include "sfml_surface.hpp"
+#include <iostream>
+
+namespace
+{
+    class SfmlImage : public SurfaceImage
+    {
+    public:
+        sf::Texture texture;
+
+        sf::Vector2u size() const override { return texture.getSize(); }
+        void update(const std::uint8_t *pixels) override { texture.update(pixels); }
+        void update(const std::uint8_t *pixels, sf::Vector2u regionSize, sf::Vector2u dest) override
+        {
+            texture.update(pixels, regionSize, dest);
+        }
+    };
+}
+
+void SfmlSurface::drawVertices(const sf::Vertex *vertices, std::size_t count, sf::PrimitiveType type)
+{
+    if (count > 0)
+        m_target.draw(vertices, count, type);
+}
+
+std::unique_ptr<SurfaceImage> SfmlSurface::createImage(sf::Vector2u size)
+{
+    auto image = std::make_unique<SfmlImage>();
+    if (!image->texture.resize(size))
+    {
+        std::cerr << "[ERROR] Failed to create " << size.x << "x" << size.y << " texture" << std::endl;
+        return nullptr;
+    }
+
+    // Repeating lets drawImage() scroll by offsetting texture coordinates
+    image->texture.setRepeated(true);
+    return image;
+}
+
+void SfmlSurface::drawImage(const SurfaceImage &image, sf::FloatRect dest, float scrollX)
+{
+    const sf::Texture &texture = static_cast<const SfmlImage &>(image).texture;
+    const sf::Vector2f size(texture.getSize());
+    const float left = dest.position.x;
+    const float top = dest.position.y;
+    const float right = left + dest.size.x;
+    const float bottom = top + dest.size.y;
+
+    // Texture coordinates are in texels
+    const sf::Vertex quad[6] = {
+        {{left, top}, sf::Color::White, {scrollX, 0.0f}},
+        {{right, top}, sf::Color::White, {scrollX + size.x, 0.0f}},
+        {{right, bottom}, sf::Color::White, {scrollX + size.x, size.y}},
+        {{left, top}, sf::Color::White, {scrollX, 0.0f}},
+        {{right, bottom}, sf::Color::White, {scrollX + size.x, size.y}},
+        {{left, bottom}, sf::Color::White, {scrollX, size.y}},
+    };
+    m_target.draw(quad, 6, sf::PrimitiveType::Triangles, sf::RenderStates(&texture));
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include "render_surface.hpp"
+
+// RenderSurface over an SFML render target (the window); images are textures
+class SfmlSurface : public RenderSurface
+{
+public:
+    explicit SfmlSurface(sf::RenderTarget &target) : m_target(target) {}
+
+    sf::Vector2u size() const override { return m_target.getSize(); }
+    void clear(sf::Color color) override { m_target.clear(color); }
+
+    void drawVertices(const sf::Vertex *vertices, std::size_t count, sf::PrimitiveType type) override;
+    std::unique_ptr<SurfaceImage> createImage(sf::Vector2u size) override;
+    void drawImage(const SurfaceImage &image, sf::FloatRect dest, float scrollX = 0.0f) override;
+
+private:
+    sf::RenderTarget &m_target;
+};
@@ -0,0 +1,380 @@
+#include "software_surface.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SWV_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+    class SoftwareImage : public SurfaceImage
+    {
+    public:
+        explicit SoftwareImage(sf::Vector2u size)
+            : m_size(size), pixels(static_cast<std::size_t>(size.x) * size.y * 4, 0)
+        {
+        }
+
+        sf::Vector2u size() const override { return m_size; }
+
+        void update(const std::uint8_t *source) override
+        {
+            std::memcpy(pixels.data(), source, pixels.size());
+        }
+
+        void update(const std::uint8_t *source, sf::Vector2u regionSize, sf::Vector2u dest) override
+        {
+            if (dest.x + regionSize.x > m_size.x || dest.y + regionSize.y > m_size.y)
+                return;
+            for (unsigned int y = 0; y < regionSize.y; ++y)
+            {
+                std::memcpy(&pixels[((static_cast<std::size_t>(dest.y) + y) * m_size.x + dest.x) * 4],
+                            source + static_cast<std::size_t>(y) * regionSize.x * 4,
+                            static_cast<std::size_t>(regionSize.x) * 4);
+            }
+        }
+
+        sf::Vector2u m_size;
+        std::vector<std::uint8_t> pixels;
+    };
+
+    // Exact round(v / 255) for v in [0, 255 * 255]
+    inline unsigned int div255(unsigned int v)
+    {
+        v += 128;
+        return (v + (v >> 8)) >> 8;
+    }
+
+    // Source-over in straight alpha, as SFML's BlendAlpha:
+    //   rgb = src.rgb * a + dst.rgb * (1 - a),  alpha = a + dst.a * (1 - a)
+    // Both weights add up to 255, so every channel stays within 16 bits.
+    inline void blend(std::uint8_t *dst, sf::Color color)
+    {
+        const unsigned int a = color.a;
+        const unsigned int inv = 255 - a;
+        dst[0] = static_cast<std::uint8_t>(div255(color.r * a + dst[0] * inv));
+        dst[1] = static_cast<std::uint8_t>(div255(color.g * a + dst[1] * inv));
+        dst[2] = static_cast<std::uint8_t>(div255(color.b * a + dst[2] * inv));
+        dst[3] = static_cast<std::uint8_t>(div255(255 * a + dst[3] * inv));
+    }
+
+    // Blends one color over `count` consecutive pixels
+    void blendSpan(std::uint8_t *dst, std::size_t count, sf::Color color)
+    {
+        if (color.a == 0)
+            return;
+
+        const std::uint8_t rgba[4] = {color.r, color.g, color.b, color.a};
+        std::size_t i = 0;
+
+        if (color.a == 255)
+        {
+            // Opaque: plain fill
+#if defined(SWV_SSE2)
+            std::uint32_t packed;
+            std::memcpy(&packed, rgba, 4);
+            const __m128i fill = _mm_set1_epi32(static_cast<int>(packed));
+            for (; i + 4 <= count; i += 4)
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 4), fill);
+#endif
+            for (; i < count; ++i)
+                std::memcpy(dst + i * 4, rgba, 4);
+            return;
+        }
+
+#if defined(SWV_SSE2)
+        // Four pixels per step, widened to 16-bit lanes: dst * (255 - a) plus
+        // the constant source term, then the same exact /255 as div255()
+        const int a = color.a;
+        const __m128i source = _mm_set_epi16(
+            static_cast<short>(255 * a), static_cast<short>(color.b * a), static_cast<short>(color.g * a), static_cast<short>(color.r * a),
+            static_cast<short>(255 * a), static_cast<short>(color.b * a), static_cast<short>(color.g * a), static_cast<short>(color.r * a));
+        const __m128i inv = _mm_set1_epi16(static_cast<short>(255 - a));
+        const __m128i bias = _mm_set1_epi16(128);
+        const __m128i zero = _mm_setzero_si128();
+
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i *p = reinterpret_cast<__m128i *>(dst + i * 4);
+            __m128i d = _mm_loadu_si128(p);
+            __m128i lo = _mm_unpacklo_epi8(d, zero);
+            __m128i hi = _mm_unpackhi_epi8(d, zero);
+            lo = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(lo, inv), source), bias);
+            hi = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(hi, inv), source), bias);
+            lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+            hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+            _mm_storeu_si128(p, _mm_packus_epi16(lo, hi));
+        }
+#endif
+        for (; i < count; ++i)
+            blend(dst + i * 4, color);
+    }
+
+    sf::Color lerp(sf::Color a, sf::Color b, float t)
+    {
+        auto mix = [t](std::uint8_t x, std::uint8_t y)
+        {
+            return static_cast<std::uint8_t>(x + (y - x) * t + 0.5f);
+        };
+        return sf::Color(mix(a.r, b.r), mix(a.g, b.g), mix(a.b, b.b), mix(a.a, b.a));
+    }
+
+    sf::Color scaleAlpha(sf::Color color, float coverage)
+    {
+        color.a = static_cast<std::uint8_t>(color.a * coverage + 0.5f);
+        return color;
+    }
+}
+
+SoftwareSurface::SoftwareSurface(unsigned int width, unsigned int height)
+    : m_width(width), m_height(height), m_pixels(static_cast<std::size_t>(width) * height * 4, 0)
+{
+}
+
+void SoftwareSurface::clear(sf::Color color)
+{
+    if (m_pixels.empty())
+        return;
+
+    // Fill one row, then copy it down
+    const std::uint8_t rgba[4] = {color.r, color.g, color.b, color.a};
+    const std::size_t rowBytes = static_cast<std::size_t>(m_width) * 4;
+    for (std::size_t i = 0; i < rowBytes; i += 4)
+        std::memcpy(&m_pixels[i], rgba, 4);
+    for (unsigned int y = 1; y < m_height; ++y)
+        std::memcpy(&m_pixels[y * rowBytes], m_pixels.data(), rowBytes);
+}
+
+sf::Color SoftwareSurface::pixel(unsigned int x, unsigned int y) const
+{
+    const std::uint8_t *p = &m_pixels[(static_cast<std::size_t>(y) * m_width + x) * 4];
+    return sf::Color(p[0], p[1], p[2], p[3]);
+}
+
+void SoftwareSurface::blendPixel(int x, int y, sf::Color color)
+{
+    if (x < 0 || y < 0 || x >= static_cast<int>(m_width) || y >= static_cast<int>(m_height) || color.a == 0)
+        return;
+    blend(at(x, y), color);
+}
+
+void SoftwareSurface::fillTriangle(const sf::Vertex &a, const sf::Vertex &b, const sf::Vertex &c)
+{
+    const sf::Vector2f pa = a.position, pb = b.position, pc = c.position;
+    const float area = (pb.x - pa.x) * (pc.y - pa.y) - (pc.x - pa.x) * (pb.y - pa.y);
+    if (std::fabs(area) < 1e-6f)
+        return; // Degenerate (e.g. strip joins)
+
+    // Pixel centers sit at +0.5. Rows cover [top, bottom) and each span
+    // [left, right): the top-left rule, so shared edges are filled once.
+    const float minY = std::min({pa.y, pb.y, pc.y});
+    const float maxY = std::max({pa.y, pb.y, pc.y});
+    const int rowBegin = std::max(0, static_cast<int>(std::ceil(minY - 0.5f)));
+    const int rowEnd = std::min(static_cast<int>(m_height), static_cast<int>(std::ceil(maxY - 0.5f)));
+
+    // Edges with the upper endpoint first, so two triangles sharing an edge
+    // compute bit-identical crossings
+    struct Edge
+    {
+        sf::Vector2f top, bottom;
+    };
+    Edge edges[3];
+    const sf::Vector2f points[3] = {pa, pb, pc};
+    for (int e = 0; e < 3; ++e)
+    {
+        sf::Vector2f p = points[e], q = points[(e + 1) % 3];
+        bool ordered = p.y < q.y || (p.y == q.y && p.x < q.x);
+        edges[e] = ordered ? Edge{p, q} : Edge{q, p};
+    }
+
+    const bool flat = a.color == b.color && b.color == c.color;
+    const float invArea = 1.0f / area;
+
+    for (int y = rowBegin; y < rowEnd; ++y)
+    {
+        const float py = y + 0.5f;
+
+        // Exactly two edges span a row strictly inside the triangle
+        float xs[2];
+        int found = 0;
+        for (const Edge &edge : edges)
+        {
+            if (py < edge.top.y || py >= edge.bottom.y || found == 2)
+                continue;
+            float t = (py - edge.top.y) / (edge.bottom.y - edge.top.y);
+            xs[found++] = edge.top.x + (edge.bottom.x - edge.top.x) * t;
+        }
+        if (found < 2)
+            continue;
+
+        const float left = std::min(xs[0], xs[1]);
+        const float right = std::max(xs[0], xs[1]);
+        const int xBegin = std::max(0, static_cast<int>(std::ceil(left - 0.5f)));
+        const int xEnd = std::min(static_cast<int>(m_width), static_cast<int>(std::ceil(right - 0.5f)));
+        if (xBegin >= xEnd)
+            continue;
+
+        if (flat)
+        {
+            blendSpan(at(xBegin, y), static_cast<std::size_t>(xEnd - xBegin), a.color);
+            continue;
+        }
+
+        // Gouraud: barycentric weights per pixel
+        for (int x = xBegin; x < xEnd; ++x)
+        {
+            const float px = x + 0.5f;
+            const float wa = ((pb.x - px) * (pc.y - py) - (pc.x - px) * (pb.y - py)) * invArea;
+            const float wb = ((pc.x - px) * (pa.y - py) - (pa.x - px) * (pc.y - py)) * invArea;
+            const float wc = 1.0f - wa - wb;
+            auto channel = [&](std::uint8_t ca, std::uint8_t cb, std::uint8_t cc)
+            {
+                return static_cast<std::uint8_t>(std::clamp(ca * wa + cb * wb + cc * wc + 0.5f, 0.0f, 255.0f));
+            };
+            sf::Color color(channel(a.color.r, b.color.r, c.color.r), channel(a.color.g, b.color.g, c.color.g),
+                            channel(a.color.b, b.color.b, c.color.b), channel(a.color.a, b.color.a, c.color.a));
+            blend(at(x, y), color);
+        }
+    }
+}
+
+void SoftwareSurface::drawLine(const sf::Vertex &a, const sf::Vertex &b, bool skipLast)
+{
+    // Xiaolin Wu: step along the major axis one pixel at a time and split
+    // each step's coverage between the two pixels straddling the line.
+    // Work in pixel-center coordinates.
+    float x0 = a.position.x - 0.5f, y0 = a.position.y - 0.5f;
+    float x1 = b.position.x - 0.5f, y1 = b.position.y - 0.5f;
+    sf::Color c0 = a.color, c1 = b.color;
+
+    const bool steep = std::fabs(y1 - y0) > std::fabs(x1 - x0);
+    if (steep)
+    {
+        std::swap(x0, y0);
+        std::swap(x1, y1);
+    }
+
+    // Strips skip their last pixel so joints aren't blended twice; when the
+    // endpoints get swapped, that pixel moves to the start
+    bool skipFirst = false;
+    if (x0 > x1)
+    {
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+        std::swap(c0, c1);
+        std::swap(skipFirst, skipLast);
+    }
+
+    const int first = static_cast<int>(std::lround(x0)) + (skipFirst ? 1 : 0);
+    const int last = static_cast<int>(std::lround(x1)) - (skipLast ? 1 : 0);
+    const float dx = x1 - x0;
+    const float gradient = dx > 0.0f ? (y1 - y0) / dx : 0.0f;
+
+    for (int x = first; x <= last; ++x)
+    {
+        const float t = dx > 0.0f ? std::clamp((x - x0) / dx, 0.0f, 1.0f) : 0.0f;
+        const float y = y0 + gradient * (x - x0);
+        const float base = std::floor(y);
+        const float frac = y - base;
+        const sf::Color color = lerp(c0, c1, t);
+        const int iy = static_cast<int>(base);
+
+        if (steep)
+        {
+            blendPixel(iy, x, scaleAlpha(color, 1.0f - frac));
+            blendPixel(iy + 1, x, scaleAlpha(color, frac));
+        }
+        else
+        {
+            blendPixel(x, iy, scaleAlpha(color, 1.0f - frac));
+            blendPixel(x, iy + 1, scaleAlpha(color, frac));
+        }
+    }
+}
+
+void SoftwareSurface::drawVertices(const sf::Vertex *vertices, std::size_t count, sf::PrimitiveType type)
+{
+    switch (type)
+    {
+    case sf::PrimitiveType::Points:
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            blendPixel(static_cast<int>(std::floor(vertices[i].position.x)),
+                       static_cast<int>(std::floor(vertices[i].position.y)), vertices[i].color);
+        }
+        break;
+
+    case sf::PrimitiveType::Lines:
+        for (std::size_t i = 0; i + 1 < count; i += 2)
+            drawLine(vertices[i], vertices[i + 1], false);
+        break;
+
+    case sf::PrimitiveType::LineStrip:
+        for (std::size_t i = 0; i + 1 < count; ++i)
+            drawLine(vertices[i], vertices[i + 1], i + 2 < count);
+        break;
+
+    case sf::PrimitiveType::Triangles:
+        for (std::size_t i = 0; i + 2 < count; i += 3)
+            fillTriangle(vertices[i], vertices[i + 1], vertices[i + 2]);
+        break;
+
+    case sf::PrimitiveType::TriangleStrip:
+        for (std::size_t i = 0; i + 2 < count; ++i)
+            fillTriangle(vertices[i], vertices[i + 1], vertices[i + 2]);
+        break;
+
+    case sf::PrimitiveType::TriangleFan:
+        for (std::size_t i = 1; i + 1 < count; ++i)
+            fillTriangle(vertices[0], vertices[i], vertices[i + 1]);
+        break;
+    }
+}
+
+std::unique_ptr<SurfaceImage> SoftwareSurface::createImage(sf::Vector2u size)
+{
+    return std::make_unique<SoftwareImage>(size);
+}
+
+void SoftwareSurface::drawImage(const SurfaceImage &image, sf::FloatRect dest, float scrollX)
+{
+    const SoftwareImage &source = static_cast<const SoftwareImage &>(image);
+    const sf::Vector2u size = source.size();
+    if (size.x == 0 || size.y == 0 || dest.size.x <= 0.0f || dest.size.y <= 0.0f)
+        return;
+
+    const int xBegin = std::max(0, static_cast<int>(std::ceil(dest.position.x - 0.5f)));
+    const int xEnd = std::min(static_cast<int>(m_width), static_cast<int>(std::ceil(dest.position.x + dest.size.x - 0.5f)));
+    const int yBegin = std::max(0, static_cast<int>(std::ceil(dest.position.y - 0.5f)));
+    const int yEnd = std::min(static_cast<int>(m_height), static_cast<int>(std::ceil(dest.position.y + dest.size.y - 0.5f)));
+    if (xBegin >= xEnd || yBegin >= yEnd)
+        return;
+
+    // Nearest-neighbour sampling; the source column of every destination
+    // column is the same on each row, so work it out once
+    const float scaleX = size.x / dest.size.x;
+    const float scaleY = size.y / dest.size.y;
+    m_sourceColumns.resize(static_cast<std::size_t>(xEnd - xBegin));
+    for (int x = xBegin; x < xEnd; ++x)
+    {
+        long u = static_cast<long>(std::floor((x + 0.5f - dest.position.x) * scaleX + scrollX));
+        long wrapped = u % static_cast<long>(size.x);
+        m_sourceColumns[x - xBegin] = static_cast<unsigned int>(wrapped < 0 ? wrapped + size.x : wrapped);
+    }
+
+    for (int y = yBegin; y < yEnd; ++y)
+    {
+        unsigned int v = std::min(size.y - 1, static_cast<unsigned int>((y + 0.5f - dest.position.y) * scaleY));
+        const std::uint8_t *row = &source.pixels[static_cast<std::size_t>(v) * size.x * 4];
+        std::uint8_t *out = at(xBegin, y);
+        for (int x = xBegin; x < xEnd; ++x, out += 4)
+        {
+            const std::uint8_t *texel = row + m_sourceColumns[x - xBegin] * 4;
+            if (texel[3] != 0)
+                blend(out, sf::Color(texel[0], texel[1], texel[2], texel[3]));
+        }
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <vector>
+#include "render_surface.hpp"
+
+// RenderSurface backed by a CPU framebuffer, for headless rendering (no
+// window, no GPU): benchmarks, pixel comparisons and offline export.
+//
+// Triangles are scan-converted into horizontal spans with a top-left fill
+// rule, so quads split along a diagonal never blend a pixel twice. Flat-
+// colored spans (every bar and spoke) are filled with SIMD; lines are
+// anti-aliased. Blending matches SFML's default alpha blend.
+class SoftwareSurface : public RenderSurface
+{
+public:
+    SoftwareSurface(unsigned int width, unsigned int height);
+
+    sf::Vector2u size() const override { return {m_width, m_height}; }
+    void clear(sf::Color color) override;
+
+    void drawVertices(const sf::Vertex *vertices, std::size_t count, sf::PrimitiveType type) override;
+    std::unique_ptr<SurfaceImage> createImage(sf::Vector2u size) override;
+    void drawImage(const SurfaceImage &image, sf::FloatRect dest, float scrollX = 0.0f) override;
+
+    // Framebuffer as RGBA8, row-major, width * height * 4 bytes
+    const std::uint8_t *pixels() const { return m_pixels.data(); }
+    sf::Color pixel(unsigned int x, unsigned int y) const;
+
+private:
+    unsigned int m_width;
+    unsigned int m_height;
+    std::vector<std::uint8_t> m_pixels;
+    std::vector<unsigned int> m_sourceColumns; // drawImage() scratch
+
+    std::uint8_t *at(int x, int y) { return &m_pixels[(static_cast<std::size_t>(y) * m_width + x) * 4]; }
+
+    void blendPixel(int x, int y, sf::Color color);
+    void fillTriangle(const sf::Vertex &a, const sf::Vertex &b, const sf::Vertex &c);
+    void drawLine(const sf::Vertex &a, const sf::Vertex &b, bool skipLast);
+};
@@ -0,0 +1,82 @@
+#include "bar_mapping.hpp"
+#include <algorithm>
+#include <cmath>
+
+bool BarMapping::configure(int barCount, int fftSize, unsigned int sampleRate)
+{
+    if (barCount == (int)m_bands.size() && fftSize == m_fftSize && sampleRate == m_sampleRate)
+        return false;
+
+    m_fftSize = fftSize;
+    m_sampleRate = sampleRate;
+    m_bands.resize(std::max(barCount, 0));
+
+    const int binCount = fftSize / 2 + 1;
+
+    // Bin k is centered on k * sampleRate / fftSize and covers [k - 0.5, k + 0.5)
+    const float binsPerHz = (float)fftSize / sampleRate;
+    const float maxHz = std::min(MAX_HZ, sampleRate * 0.5f);
+    const float ratio = std::log(maxHz / MIN_HZ);
+    const float maxPos = binCount - 0.5f;
+
+    for (int i = 0; i < barCount; ++i)
+    {
+        float lo = MIN_HZ * std::exp(ratio * i / barCount) * binsPerHz;
+        float hi = MIN_HZ * std::exp(ratio * (i + 1) / barCount) * binsPerHz;
+        lo = std::clamp(lo, 0.0f, maxPos);
+        hi = std::clamp(hi, lo, maxPos);
+
+        Band &band = m_bands[i];
+        band.first = std::min((int)(lo + 0.5f), binCount - 1);
+        band.last = std::min((int)(hi + 0.5f), binCount - 1);
+        band.width = std::max(hi - lo, 1e-6f);
+        if (band.first == band.last)
+        {
+            band.firstWeight = band.width;
+            band.lastWeight = 0.0f;
+        }
+        else
+        {
+            band.firstWeight = (band.first + 0.5f) - lo;
+            band.lastWeight = hi - (band.last - 0.5f);
+        }
+    }
+    return true;
+}
+
+void BarMapping::apply(const float *bins, BandAggregate mode, float *out)
+{
+    if (mode == BandAggregate::Max)
+    {
+        // Bands don't overlap, so this touches each bin about once per frame
+        for (size_t i = 0; i < m_bands.size(); ++i)
+        {
+            const Band &band = m_bands[i];
+            float peak = bins[band.first];
+            for (int k = band.first + 1; k <= band.last; ++k)
+                peak = std::max(peak, bins[k]);
+            out[i] = peak;
+        }
+        return;
+    }
+
+    // Weighted sum over the band's own bins: partial edges, whole bins between
+    const bool squares = mode == BandAggregate::Rms;
+    for (size_t i = 0; i < m_bands.size(); ++i)
+    {
+        const Band &band = m_bands[i];
+        float first = squares ? bins[band.first] * bins[band.first] : bins[band.first];
+        float sum = first * band.firstWeight;
+        if (band.last > band.first)
+        {
+            float inner = 0.0f;
+            for (int k = band.first + 1; k < band.last; ++k)
+                inner += squares ? bins[k] * bins[k] : bins[k];
+            float last = squares ? bins[band.last] * bins[band.last] : bins[band.last];
+            sum += inner + last * band.lastWeight;
+        }
+
+        float mean = sum / band.width;
+        out[i] = squares ? std::sqrt(std::max(mean, 0.0f)) : mean;
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <vector>
+
+// How the FFT bins that fall inside one bar's frequency band are combined
+enum class BandAggregate
+{
+    Mean,
+    Max,
+    Rms
+};
+
+// Precomputed mapping from FFT bins to log-spaced frequency bands.
+//
+// Each band covers a continuous range of bin positions; bins only partially
+// inside it are weighted by the covered fraction, so every bin contributes and
+// narrow low-frequency bands don't alias. The table is rebuilt only when the
+// bar count, FFT size or sample rate changes.
+//
+// apply() reads each bin the bands cover once (edge bins twice) and nothing
+// else, so a frame costs O(bars + covered bins). The bins are new every
+// frame, so no table built ahead of time can avoid reading them; bins above
+// MAX_HZ are skipped entirely.
+class BarMapping
+{
+public:
+    static constexpr float MIN_HZ = 30.0f;
+    static constexpr float MAX_HZ = 16000.0f;
+
+    // Returns true if the table had to be rebuilt
+    bool configure(int barCount, int fftSize, unsigned int sampleRate);
+
+    // Writes one aggregated value per bar into out (barCount entries).
+    // `bins` must hold fftSize / 2 + 1 values.
+    void apply(const float *bins, BandAggregate mode, float *out);
+
+    int barCount() const { return (int)m_bands.size(); }
+
+private:
+    struct Band
+    {
+        int first;         // First bin touched by the band
+        int last;          // Last bin touched by the band (inclusive)
+        float firstWeight; // Covered fraction of `first`
+        float lastWeight;  // Covered fraction of `last` (unused when first == last)
+        float width;       // Total weight, in bins
+    };
+
+    std::vector<Band> m_bands;
+    int m_fftSize = 0;
+    unsigned int m_sampleRate = 0;
+};
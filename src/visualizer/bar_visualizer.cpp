@@ -1,130 +1,189 @@
 #include "bar_visualizer.hpp"
 #include <cmath>
-#include <cstdlib>
-#include <ctime>
 #include <algorithm>
+#include "smoothing.hpp"
+
+namespace
+{
+    const sf::Color PEAK_COLOR(255, 255, 255, 230);
+    constexpr float PEAK_THICKNESS = 2.0f;
+
+    // Bar values are FFT dB / 60 with a gain of 2, so 1.0 spans 30 dB
+    constexpr float DB_PER_UNIT = 30.0f;
+}
 
 BarVisualizer::BarVisualizer(int barCount, float width, float height)
     : m_barCount(barCount), m_width(width), m_height(height)
 {
-    std::srand(static_cast<unsigned int>(std::time(nullptr)));
-    m_smoothedValues.resize(barCount, 0.0f);
+    m_targets.resize(barCount, 0.0f);
+    m_smoothed.resize(barCount, 0.0f);
+    m_colorIdx.resize(barCount, 0);
+    m_peak.resize(barCount, 0.0f);
+    m_peakHold.resize(barCount, 0.0f);
+    m_attackCoef.resize(barCount);
+    m_releaseCoef.resize(barCount);
+    setTimeConstants(0.03f, 0.12f);
+    setPeakHold(true, 0.8f, 20.0f);
     setupBars();
 }
 
+void BarVisualizer::setTimeConstants(float attackSeconds, float releaseSeconds)
+{
+    m_attackTau.assign(m_barCount, std::max(attackSeconds, 1e-4f));
+    m_releaseTau.resize(m_barCount);
+    for (int i = 0; i < m_barCount; ++i)
+    {
+        float bass = 1.0f - static_cast<float>(i) / m_barCount;
+        m_releaseTau[i] = std::max(releaseSeconds * (1.0f + bass), 1e-4f);
+    }
+}
+
+void BarVisualizer::updateCoefficients(float dt)
+{
+    // Fraction of the remaining distance covered in dt: 1 - e^(-dt / tau)
+    for (int i = 0; i < m_barCount; ++i)
+    {
+        m_attackCoef[i] = 1.0f - std::exp(-dt / m_attackTau[i]);
+        m_releaseCoef[i] = 1.0f - std::exp(-dt / m_releaseTau[i]);
+    }
+}
+
 void BarVisualizer::setupBars()
 {
-    m_bars.clear();
-    m_bars.reserve(m_barCount);
+    // All bars, followed by all peak markers, live in one vertex array (two
+    // triangles each), rewritten in place every frame and drawn with a single
+    // draw call
+    m_vertices.setPrimitiveType(sf::PrimitiveType::Triangles);
+    m_vertices.resize(static_cast<std::size_t>(m_barCount) * 12);
+
+    // Shrink the gap for very high bar counts so bars never vanish
+    m_gap = std::min(2.0f, m_width / m_barCount * 0.25f);
+    float totalGapSpace = m_gap * (m_barCount - 1);
+    m_barWidth = (m_width - totalGapSpace) / m_barCount;
+}
 
-    float gap = 2.0f;
-    float totalGapSpace = gap * (m_barCount - 1);
-    float barWidth = (m_width - totalGapSpace) / m_barCount;
+void BarVisualizer::writeQuad(int slot, float left, float right, float top, float bottom, sf::Color color)
+{
+    sf::Vertex *quad = &m_vertices[static_cast<std::size_t>(slot) * 6];
+    quad[0].position = {left, bottom};
+    quad[1].position = {right, bottom};
+    quad[2].position = {right, top};
+    quad[3].position = {left, bottom};
+    quad[4].position = {right, top};
+    quad[5].position = {left, top};
+    for (int v = 0; v < 6; ++v)
+        quad[v].color = color;
+}
+
+void BarVisualizer::setPeakHold(bool enabled, float holdSeconds, float decayDbPerSecond)
+{
+    m_peaksEnabled = enabled;
+    m_peakHoldTime = std::max(holdSeconds, 0.0f);
+    m_peakDecay = std::max(decayDbPerSecond, 0.0f) / DB_PER_UNIT;
+}
 
+void BarVisualizer::updatePeaks(float dt)
+{
+    float *peak = m_peak.data();
+    float *hold = m_peakHold.data();
+    const float *smoothed = m_smoothed.data();
+    const float holdTime = m_peakHoldTime;
+    const float decay = m_peakDecay * dt;
+
+    // A bar reaching its marker pushes it up and restarts the hold; once the
+    // hold runs out the marker falls at a constant dB rate
     for (int i = 0; i < m_barCount; ++i)
     {
-        sf::RectangleShape bar;
-        bar.setSize({barWidth, 10.0f});
-        bar.setFillColor(sf::Color(0, 255, 255, 200));
-
-        float xPos = i * (barWidth + gap);
-        bar.setPosition({xPos, m_height});
-        m_bars.push_back(bar);
+        bool rising = smoothed[i] >= peak[i];
+        hold[i] = rising ? holdTime : hold[i] - dt;
+        float falling = hold[i] > 0.0f ? peak[i] : std::max(peak[i] - decay, smoothed[i]);
+        peak[i] = rising ? smoothed[i] : falling;
     }
 }
 
-void BarVisualizer::setSize(float width, float height)
+AnalysisRequirements BarVisualizer::requirements() const
+{
+    AnalysisRequirements requirements;
+    requirements.products = ANALYSIS_SPECTRUM;
+    return requirements;
+}
+
+void BarVisualizer::resize(float width, float height)
 {
     m_width = width;
     m_height = height;
     setupBars();
 }
 
-void BarVisualizer::update(const std::vector<float> &fftData)
+void BarVisualizer::update(const AnalysisFrame &frame, float dt)
 {
-    // === DEMO MODE (if no FFT data) ===
+    const std::vector<float> &fftData = frame.bins;
+    dt = std::max(dt, 0.0f);
+
+    // Aggregate FFT bins into log-spaced bands (lower frequencies get more
+    // bars, they contain more musical info). The table is only rebuilt when
+    // the bar count, FFT size or sample rate changes. Without a spectrum the
+    // bars just fall back to rest; use a synthetic source to test the view.
     if (fftData.empty())
     {
-        static float time = 0.0f;
-        time += 0.05f;
-
-        for (int i = 0; i < m_barCount; ++i)
-        {
-            float wave1 = std::sin(time + i * 0.2f);
-            float wave2 = std::sin(time * 0.5f + i * 0.1f);
-            float intensity = (wave1 + wave2 + 2.0f) / 4.0f;
-            float jitter = (static_cast<float>(rand() % 100) / 100.0f) * 0.2f;
-            intensity += jitter;
-
-            float barHeight = intensity * (m_height * 0.8f);
-            if (barHeight < 5.0f)
-                barHeight = 5.0f;
-
-            m_smoothedValues[i] = barHeight;
-            sf::Vector2f currentSize = m_bars[i].getSize();
-            m_bars[i].setSize({currentSize.x, -barHeight});
-
-            sf::Color color = sf::Color(0, 255, 255, 200);
-            if (intensity > 0.8f)
-                color = sf::Color(255, 255, 255, 220);
-            m_bars[i].setFillColor(color);
-        }
-        return;
+        std::fill(m_targets.begin(), m_targets.end(), 0.0f);
     }
+    else
+    {
+        int fftSize = (static_cast<int>(fftData.size()) - 1) * 2;
+        m_mapping.configure(m_barCount, fftSize, m_sampleRate);
+        m_mapping.apply(fftData.data(), m_aggregate, m_targets.data());
+    }
+
+    updateCoefficients(dt);
 
-    // === REAL FFT DATA MODE ===
-    // Map FFT bins to our bar count
-    int fftSize = static_cast<int>(fftData.size());
+    float *targets = m_targets.data();
+    float *smoothed = m_smoothed.data();
+    std::uint8_t *colorIdx = m_colorIdx.data();
+    const float *attack = m_attackCoef.data();
+    const float *release = m_releaseCoef.data();
 
+    // Branch-free loops over plain arrays so the compiler can vectorize them
     for (int i = 0; i < m_barCount; ++i)
     {
-        // Map bar index to FFT bin range (logarithmic scaling for better visuals)
-        // Lower frequencies get more bars (they contain more musical info)
-        float t = static_cast<float>(i) / m_barCount;
-        int fftIndex = static_cast<int>(std::pow(t, 2.0f) * (fftSize / 2));
-        fftIndex = std::clamp(fftIndex, 0, fftSize - 1);
-
-        // Get the FFT value (0.0 to 1.0)
-        float value = fftData[fftIndex];
-
-        // Apply some gain/scaling
-        value = std::clamp(value * 2.0f, 0.0f, 1.0f);
-
-        // Smooth the transition (prevents jittery bars)
-        float smoothing = 0.3f; // Lower = smoother, Higher = more reactive
-        m_smoothedValues[i] = m_smoothedValues[i] * (1.0f - smoothing) + value * smoothing;
-
-        // Calculate bar height
-        float barHeight = m_smoothedValues[i] * (m_height * 0.9f);
-        if (barHeight < 2.0f)
-            barHeight = 2.0f;
-
-        // Update bar
-        sf::Vector2f currentSize = m_bars[i].getSize();
-        m_bars[i].setSize({currentSize.x, -barHeight});
-
-        // Dynamic color based on intensity
-        sf::Color color;
-        if (m_smoothedValues[i] > 0.8f)
-        {
-            color = sf::Color(255, 100, 100, 230); // Red for peaks
-        }
-        else if (m_smoothedValues[i] > 0.5f)
-        {
-            color = sf::Color(255, 255, 100, 220); // Yellow for mid
-        }
-        else
-        {
-            color = sf::Color(0, 255, 255, 200); // Cyan for low
-        }
-        m_bars[i].setFillColor(color);
+        // Apply some gain/scaling, then smooth the transition (prevents jittery bars)
+        targets[i] = std::clamp(targets[i] * 2.0f, 0.0f, 1.0f);
+        float coef = targets[i] > smoothed[i] ? attack[i] : release[i];
+        smoothed[i] = smoothLevel(smoothed[i], targets[i], coef);
     }
+
+    // Dynamic color based on intensity, looked up in the baked gradient
+    for (int i = 0; i < m_barCount; ++i)
+    {
+        colorIdx[i] = static_cast<std::uint8_t>(smoothed[i] * (ColorGradient::LUT_SIZE - 1) + 0.5f);
+    }
+
+    updatePeaks(dt);
 }
 
-void BarVisualizer::draw(sf::RenderWindow &window)
+void BarVisualizer::draw(RenderSurface &surface)
 {
-    for (const auto &bar : m_bars)
+    // Geometry is generated from the bar state only here, once per drawn frame
+    const float maxHeight = m_height * 0.9f;
+    for (int i = 0; i < m_barCount; ++i)
     {
-        window.draw(bar);
+        float left = i * (m_barWidth + m_gap);
+        float barHeight = std::max(m_smoothed[i] * maxHeight, 2.0f);
+        writeQuad(i, left, left + m_barWidth, m_height - barHeight, m_height, m_gradient[m_colorIdx[i]]);
     }
-}
\ No newline at end of file
+
+    std::size_t vertexCount = static_cast<std::size_t>(m_barCount) * 6;
+    if (m_peaksEnabled)
+    {
+        // Markers sit just above the bar level they remember
+        for (int i = 0; i < m_barCount; ++i)
+        {
+            float left = i * (m_barWidth + m_gap);
+            float top = m_height - std::max(m_peak[i] * maxHeight, 2.0f) - PEAK_THICKNESS;
+            writeQuad(m_barCount + i, left, left + m_barWidth, top, top + PEAK_THICKNESS, PEAK_COLOR);
+        }
+        vertexCount *= 2;
+    }
+
+    surface.drawVertices(&m_vertices[0], vertexCount, sf::PrimitiveType::Triangles);
+}
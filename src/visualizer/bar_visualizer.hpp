@@ -1,25 +1,77 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <cstdint>
 #include <vector>
+#include "bar_mapping.hpp"
+#include "color_gradient.hpp"
+#include "visualizer_base.hpp"
 
-class BarVisualizer
+class BarVisualizer : public VisualizerBase
 {
 public:
     BarVisualizer(int barCount, float width, float height);
 
-    // Update bars with FFT data (empty = demo mode)
-    void update(const std::vector<float> &fftData);
+    // Update bars with the frame's spectrum (none yet = bars at rest). dt is the
+    // real time in seconds since the previous update, so the animation looks
+    // the same at any frame rate and when frames are skipped.
+    void update(const AnalysisFrame &frame, float dt) override;
 
-    void draw(sf::RenderWindow &window);
-    void setSize(float width, float height);
+    void draw(RenderSurface &surface) override;
+    void resize(float width, float height) override;
+
+    AnalysisRequirements requirements() const override;
+
+    // Needed to place the log-spaced bands; defaults to 44.1 kHz
+    void setSampleRate(unsigned int sampleRate) { m_sampleRate = sampleRate; }
+    void setAggregate(BandAggregate mode) { m_aggregate = mode; }
+
+    // Exponential smoothing time constants in seconds: attack while a bar
+    // rises, release while it falls. Bass bars get a proportionally longer
+    // release (up to 2x) so low-frequency content doesn't flicker.
+    void setTimeConstants(float attackSeconds, float releaseSeconds);
+
+    // Per-bar peak markers that hold for `holdSeconds` after the bar last
+    // reached them, then fall at `decayDbPerSecond`
+    void setPeakHold(bool enabled, float holdSeconds, float decayDbPerSecond);
+
+    // Maps bar intensity (0..1) to color
+    void setGradient(const ColorGradient &gradient) { m_gradient = gradient; }
 
 private:
     int m_barCount;
     float m_width;
     float m_height;
 
-    std::vector<sf::RectangleShape> m_bars;
-    std::vector<float> m_smoothedValues; // For smooth animation
+    // Per-bar state as parallel arrays, so the per-frame update is a few
+    // straight loops over floats. Geometry is derived from it in draw().
+    std::vector<float> m_targets;         // Latest band values after gain, 0..1
+    std::vector<float> m_smoothed;        // For smooth animation, 0..1
+    std::vector<std::uint8_t> m_colorIdx; // Index into the gradient LUT
+    std::vector<float> m_attackTau;       // Seconds
+    std::vector<float> m_releaseTau;      // Seconds
+    std::vector<float> m_peak;            // Held peak level, 0..1
+    std::vector<float> m_peakHold;        // Seconds of hold left
+
+    // Per-bar blend factors for the current dt. The measured dt differs on
+    // almost every frame, so they're recomputed on every update.
+    std::vector<float> m_attackCoef;
+    std::vector<float> m_releaseCoef;
+
+    bool m_peaksEnabled = true;
+    float m_peakHoldTime = 0.0f; // Seconds
+    float m_peakDecay = 0.0f;    // Bar units per second
+
+    float m_barWidth = 0.0f;
+    float m_gap = 0.0f;
+    sf::VertexArray m_vertices; // 6 vertices per bar, then 6 per peak marker, drawn in one call
+
+    unsigned int m_sampleRate = 44100;
+    BandAggregate m_aggregate = BandAggregate::Max;
+    BarMapping m_mapping;
+    ColorGradient m_gradient;
 
     void setupBars();
-};
\ No newline at end of file
+    void updateCoefficients(float dt);
+    void updatePeaks(float dt);
+    void writeQuad(int slot, float left, float right, float top, float bottom, sf::Color color);
+};
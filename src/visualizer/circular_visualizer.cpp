@@ -0,0 +1,138 @@
+#include "circular_visualizer.hpp"
+#include <algorithm>
+#include <cmath>
+#include "smoothing.hpp"
+
+namespace
+{
+    constexpr float TWO_PI = 6.28318530718f;
+
+    // Radii as fractions of half the smaller window side
+    constexpr float INNER_RADIUS = 0.4f;
+    constexpr float MAX_LENGTH = 0.58f;
+
+    // Share of each spoke's slot at the inner circle that the spoke covers
+    constexpr float SPOKE_FILL = 0.7f;
+}
+
+CircularVisualizer::CircularVisualizer(int spokeCount, float width, float height)
+    : m_spokeCount(std::max(spokeCount, 1)), m_width(width), m_height(height)
+{
+    m_targets.resize(m_spokeCount, 0.0f);
+    m_smoothed.resize(m_spokeCount, 0.0f);
+    m_colorIdx.resize(m_spokeCount, 0);
+    setupSpokes();
+}
+
+void CircularVisualizer::setTimeConstants(float attackSeconds, float releaseSeconds)
+{
+    m_attackTau = std::max(attackSeconds, 1e-4f);
+    m_releaseTau = std::max(releaseSeconds, 1e-4f);
+}
+
+void CircularVisualizer::setupSpokes()
+{
+    m_vertices.setPrimitiveType(sf::PrimitiveType::TriangleStrip);
+    m_vertices.resize(static_cast<std::size_t>(m_spokeCount) * 6);
+
+    m_dirX.resize(m_spokeCount);
+    m_dirY.resize(m_spokeCount);
+    m_innerLeft.resize(m_spokeCount);
+    m_innerRight.resize(m_spokeCount);
+
+    const sf::Vector2f center(m_width * 0.5f, m_height * 0.5f);
+    const float halfSide = std::min(m_width, m_height) * 0.5f;
+    const float inner = halfSide * INNER_RADIUS;
+    const float halfWidth = TWO_PI * inner / m_spokeCount * SPOKE_FILL * 0.5f;
+    m_maxLength = halfSide * MAX_LENGTH;
+
+    // Lowest band starts at the top and the spectrum runs clockwise
+    for (int i = 0; i < m_spokeCount; ++i)
+    {
+        float angle = TWO_PI * i / m_spokeCount - TWO_PI * 0.25f;
+        float dx = std::cos(angle);
+        float dy = std::sin(angle);
+        m_dirX[i] = dx;
+        m_dirY[i] = dy;
+
+        sf::Vector2f base(center.x + dx * inner, center.y + dy * inner);
+        sf::Vector2f side(-dy * halfWidth, dx * halfWidth);
+        m_innerLeft[i] = base - side;
+        m_innerRight[i] = base + side;
+    }
+}
+
+AnalysisRequirements CircularVisualizer::requirements() const
+{
+    AnalysisRequirements requirements;
+    requirements.products = ANALYSIS_SPECTRUM;
+    return requirements;
+}
+
+void CircularVisualizer::resize(float width, float height)
+{
+    m_width = width;
+    m_height = height;
+    setupSpokes();
+}
+
+void CircularVisualizer::update(const AnalysisFrame &frame, float dt)
+{
+    dt = std::max(dt, 0.0f);
+
+    // Without a spectrum the spokes just fall back to rest
+    if (frame.bins.empty())
+    {
+        std::fill(m_targets.begin(), m_targets.end(), 0.0f);
+    }
+    else
+    {
+        int fftSize = (static_cast<int>(frame.bins.size()) - 1) * 2;
+        m_mapping.configure(m_spokeCount, fftSize, m_sampleRate);
+        m_mapping.apply(frame.bins.data(), m_aggregate, m_targets.data());
+    }
+
+    const float attack = 1.0f - std::exp(-dt / m_attackTau);
+    const float release = 1.0f - std::exp(-dt / m_releaseTau);
+
+    float *targets = m_targets.data();
+    float *smoothed = m_smoothed.data();
+    std::uint8_t *colorIdx = m_colorIdx.data();
+
+    for (int i = 0; i < m_spokeCount; ++i)
+    {
+        targets[i] = std::clamp(targets[i] * 2.0f, 0.0f, 1.0f);
+        float coef = targets[i] > smoothed[i] ? attack : release;
+        smoothed[i] = smoothLevel(smoothed[i], targets[i], coef);
+    }
+
+    for (int i = 0; i < m_spokeCount; ++i)
+    {
+        colorIdx[i] = static_cast<std::uint8_t>(smoothed[i] * (ColorGradient::LUT_SIZE - 1) + 0.5f);
+    }
+}
+
+void CircularVisualizer::draw(RenderSurface &surface)
+{
+    // Each spoke is written as innerL, innerL, innerR, outerL, outerR, outerR.
+    // The repeated first and last vertices give zero-area triangles that
+    // bridge to the next spoke within the same strip.
+    sf::Vertex *v = &m_vertices[0];
+    for (int i = 0; i < m_spokeCount; ++i, v += 6)
+    {
+        float length = std::max(m_smoothed[i] * m_maxLength, 2.0f);
+        sf::Vector2f out(m_dirX[i] * length, m_dirY[i] * length);
+        sf::Color color = m_gradient[m_colorIdx[i]];
+
+        v[0].position = m_innerLeft[i];
+        v[1].position = m_innerLeft[i];
+        v[2].position = m_innerRight[i];
+        v[3].position = m_innerLeft[i] + out;
+        v[4].position = m_innerRight[i] + out;
+        v[5].position = v[4].position;
+        for (int k = 0; k < 6; ++k)
+            v[k].color = color;
+    }
+
+    surface.drawVertices(&m_vertices[0], m_vertices.getVertexCount(), sf::PrimitiveType::TriangleStrip);
+}
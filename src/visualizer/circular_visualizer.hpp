@@ -0,0 +1,64 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+#include "bar_mapping.hpp"
+#include "color_gradient.hpp"
+#include "visualizer_base.hpp"
+
+// Radial spectrum: one spoke per band around a circle in the window center.
+//
+// Spoke directions and widths only change with the layout, so their sin/cos
+// are baked into tables in setupSpokes() and a frame is a few multiply-adds
+// per spoke. All spokes live in one triangle strip, joined by degenerate
+// triangles, and go out in a single draw call.
+class CircularVisualizer : public VisualizerBase
+{
+public:
+    CircularVisualizer(int spokeCount, float width, float height);
+
+    void update(const AnalysisFrame &frame, float dt) override;
+    void draw(RenderSurface &surface) override;
+    void resize(float width, float height) override;
+
+    AnalysisRequirements requirements() const override;
+
+    // Needed to place the log-spaced bands; defaults to 44.1 kHz
+    void setSampleRate(unsigned int sampleRate) { m_sampleRate = sampleRate; }
+    void setAggregate(BandAggregate mode) { m_aggregate = mode; }
+
+    // Attack/release smoothing time constants in seconds
+    void setTimeConstants(float attackSeconds, float releaseSeconds);
+
+    void setGradient(const ColorGradient &gradient) { m_gradient = gradient; }
+
+private:
+    int m_spokeCount;
+    float m_width;
+    float m_height;
+
+    // Per-spoke state, as in BarVisualizer
+    std::vector<float> m_targets;         // 0..1
+    std::vector<float> m_smoothed;        // 0..1
+    std::vector<std::uint8_t> m_colorIdx; // Index into the gradient LUT
+
+    // Layout tables, rebuilt by setupSpokes(): unit direction of each spoke
+    // and the two inner corners of its quad
+    std::vector<float> m_dirX;
+    std::vector<float> m_dirY;
+    std::vector<sf::Vector2f> m_innerLeft;
+    std::vector<sf::Vector2f> m_innerRight;
+    float m_maxLength = 0.0f;
+
+    float m_attackTau = 0.03f;
+    float m_releaseTau = 0.12f;
+
+    sf::VertexArray m_vertices; // 6 per spoke: a quad plus 2 degenerate joins
+
+    unsigned int m_sampleRate = 44100;
+    BandAggregate m_aggregate = BandAggregate::Max;
+    BarMapping m_mapping;
+    ColorGradient m_gradient;
+
+    void setupSpokes();
+};
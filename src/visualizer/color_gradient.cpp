@@ -0,0 +1,70 @@
+#include "color_gradient.hpp"
+#include <algorithm>
+
+namespace
+{
+    std::vector<GradientStop> defaultStops()
+    {
+        return {
+            {0.0f, sf::Color(0, 255, 255, 200)},   // Cyan for low
+            {0.5f, sf::Color(255, 255, 100, 220)}, // Yellow for mid
+            {1.0f, sf::Color(255, 100, 100, 230)}, // Red for peaks
+        };
+    }
+
+    std::uint8_t lerp(std::uint8_t a, std::uint8_t b, float t)
+    {
+        return static_cast<std::uint8_t>(a + (b - a) * t + 0.5f);
+    }
+}
+
+ColorGradient::ColorGradient()
+{
+    setStops(defaultStops());
+}
+
+ColorGradient::ColorGradient(std::vector<GradientStop> stops)
+{
+    setStops(std::move(stops));
+}
+
+void ColorGradient::setStops(std::vector<GradientStop> stops)
+{
+    if (stops.empty())
+        stops = defaultStops();
+
+    std::stable_sort(stops.begin(), stops.end(), [](const GradientStop &a, const GradientStop &b)
+                     { return a.position < b.position; });
+    m_stops = std::move(stops);
+    bake();
+}
+
+void ColorGradient::bake()
+{
+    size_t next = 0;
+    for (int i = 0; i < LUT_SIZE; ++i)
+    {
+        float t = static_cast<float>(i) / (LUT_SIZE - 1);
+        while (next < m_stops.size() && m_stops[next].position < t)
+            ++next;
+
+        // Clamp to the end colors outside the stop range
+        if (next == 0)
+        {
+            m_lut[i] = m_stops.front().color;
+            continue;
+        }
+        if (next == m_stops.size())
+        {
+            m_lut[i] = m_stops.back().color;
+            continue;
+        }
+
+        const GradientStop &a = m_stops[next - 1];
+        const GradientStop &b = m_stops[next];
+        float span = b.position - a.position;
+        float f = span > 0.0f ? (t - a.position) / span : 1.0f;
+        m_lut[i] = sf::Color(lerp(a.color.r, b.color.r, f), lerp(a.color.g, b.color.g, f),
+                             lerp(a.color.b, b.color.b, f), lerp(a.color.a, b.color.a, f));
+    }
+}
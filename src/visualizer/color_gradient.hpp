@@ -0,0 +1,44 @@
+#pragma once
+#include <SFML/Graphics/Color.hpp>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+struct GradientStop
+{
+    float position; // 0..1
+    sf::Color color;
+};
+
+// Intensity-to-color gradient baked into a lookup table once, so coloring a
+// bar, spectrogram cell or particle is a single indexed load.
+class ColorGradient
+{
+public:
+    static constexpr int LUT_SIZE = 256;
+
+    ColorGradient(); // Cyan -> yellow -> red
+    explicit ColorGradient(std::vector<GradientStop> stops);
+
+    // Re-bakes the table. Stops are sorted by position; fewer than one stop
+    // falls back to the default gradient.
+    void setStops(std::vector<GradientStop> stops);
+    const std::vector<GradientStop> &stops() const { return m_stops; }
+
+    // Table index for an intensity in 0..1 (clamped)
+    static std::uint8_t indexOf(float t)
+    {
+        t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+        return static_cast<std::uint8_t>(t * (LUT_SIZE - 1) + 0.5f);
+    }
+
+    sf::Color operator[](std::uint8_t index) const { return m_lut[index]; }
+    sf::Color at(float t) const { return m_lut[indexOf(t)]; }
+    const sf::Color *data() const { return m_lut.data(); }
+
+private:
+    std::vector<GradientStop> m_stops;
+    std::array<sf::Color, LUT_SIZE> m_lut;
+
+    void bake();
+};
@@ -0,0 +1,184 @@
+#include "goniometer_visualizer.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr float INV_SQRT2 = 0.70710678f;
+
+    // Intensity added per sample pair; a spot hit this often saturates
+    constexpr float HIT_WEIGHT = 0.08f;
+
+    // Full-scale samples reach this fraction of the half-side
+    constexpr float SCALE = 0.95f;
+
+    // Below this a pixel is drawn fully transparent anyway, so it is snapped
+    // to dark and leaves the lit span instead of fading forever
+    constexpr float REST_LEVEL = 0.5f / 255.0f;
+
+    // Pairs attached to each frame, about 100 ms at 44.1 kHz: more than the
+    // gap between two presented frames, so none go undrawn
+    constexpr unsigned int MAX_PAIRS = 4096;
+}
+
+GoniometerVisualizer::GoniometerVisualizer(float width, float height)
+    : m_width(width), m_height(height)
+{
+    setupBuffer();
+}
+
+void GoniometerVisualizer::setupBuffer()
+{
+    m_side = std::max(1u, static_cast<unsigned int>(std::min(m_width, m_height)));
+    m_intensity.assign(static_cast<std::size_t>(m_side) * m_side, 0.0f);
+    m_pixels.assign(m_intensity.size() * 4, 0);
+    m_litBegin.assign(m_side, 0);
+    m_litEnd.assign(m_side, 0);
+    m_dirtyBegin = m_dirtyEnd = 0;
+    m_fullUpload = true;
+
+    // Recreated at the new size on the next draw
+    m_image.reset();
+    m_imageSurface = nullptr;
+}
+
+AnalysisRequirements GoniometerVisualizer::requirements() const
+{
+    AnalysisRequirements requirements;
+    requirements.products = ANALYSIS_STEREO;
+    requirements.stereoMaxPairs = MAX_PAIRS;
+    return requirements;
+}
+
+void GoniometerVisualizer::resize(float width, float height)
+{
+    m_width = width;
+    m_height = height;
+    setupBuffer();
+}
+
+void GoniometerVisualizer::colorPixel(std::size_t index)
+{
+    // Color through the LUT; alpha follows intensity so empty space stays clear
+    float level = std::min(m_intensity[index], 1.0f);
+    sf::Color color = m_gradient[ColorGradient::indexOf(level)];
+    std::uint8_t *pixel = &m_pixels[index * 4];
+    pixel[0] = color.r;
+    pixel[1] = color.g;
+    pixel[2] = color.b;
+    pixel[3] = static_cast<std::uint8_t>(color.a * level);
+}
+
+void GoniometerVisualizer::markDirty(unsigned int row)
+{
+    if (m_dirtyBegin == m_dirtyEnd)
+    {
+        m_dirtyBegin = row;
+        m_dirtyEnd = row + 1;
+        return;
+    }
+    m_dirtyBegin = std::min(m_dirtyBegin, row);
+    m_dirtyEnd = std::max(m_dirtyEnd, row + 1);
+}
+
+void GoniometerVisualizer::update(const AnalysisFrame &frame, float dt)
+{
+    dt = std::max(dt, 0.0f);
+    float *intensity = m_intensity.data();
+
+    // Persistence: fade and recolor only what is still lit, shrinking each
+    // row's span to the pixels that stay above REST_LEVEL
+    const float fade = std::exp(-dt / m_persistence);
+    for (unsigned int y = 0; y < m_side && fade < 1.0f; ++y)
+    {
+        const unsigned int begin = m_litBegin[y];
+        const unsigned int end = m_litEnd[y];
+        if (begin == end)
+            continue;
+
+        unsigned int lo = end, hi = begin;
+        const std::size_t row = static_cast<std::size_t>(y) * m_side;
+        for (unsigned int x = begin; x < end; ++x)
+        {
+            float level = intensity[row + x] * fade;
+            if (level < REST_LEVEL)
+            {
+                level = 0.0f;
+            }
+            else
+            {
+                lo = std::min(lo, x);
+                hi = x + 1;
+            }
+            intensity[row + x] = level;
+            colorPixel(row + x);
+        }
+        m_litBegin[y] = lo < hi ? lo : 0;
+        m_litEnd[y] = lo < hi ? hi : 0;
+        markDirty(y);
+    }
+
+    // Splat only the pairs past the last frame we drew; frames overlap, and
+    // the renderer may see the same one twice
+    if ((frame.products & ANALYSIS_STEREO) && frame.sequence > m_lastSequence)
+    {
+        const std::size_t pairs = std::min(frame.stereoLeft.size(), frame.stereoRight.size());
+        const std::size_t fresh = static_cast<std::size_t>(std::min<std::uint64_t>(frame.sequence - m_lastSequence, pairs));
+        m_lastSequence = frame.sequence;
+
+        const float half = m_side * 0.5f;
+        const float scale = half * SCALE;
+        const int limit = static_cast<int>(m_side);
+        for (std::size_t i = pairs - fresh; i < pairs; ++i)
+        {
+            float l = frame.stereoLeft[i];
+            float r = frame.stereoRight[i];
+            float x = m_midSide ? (l - r) * INV_SQRT2 : l;
+            float y = m_midSide ? (l + r) * INV_SQRT2 : r;
+
+            // Screen y grows downwards
+            int px = static_cast<int>(std::floor(half + x * scale));
+            int py = static_cast<int>(std::floor(half - y * scale));
+            if (px < 0 || py < 0 || px >= limit || py >= limit)
+                continue;
+
+            const unsigned int ux = static_cast<unsigned int>(px), uy = static_cast<unsigned int>(py);
+            const std::size_t index = static_cast<std::size_t>(uy) * m_side + ux;
+            intensity[index] += HIT_WEIGHT;
+            colorPixel(index);
+
+            bool empty = m_litBegin[uy] == m_litEnd[uy];
+            m_litBegin[uy] = empty ? ux : std::min(m_litBegin[uy], ux);
+            m_litEnd[uy] = empty ? ux + 1 : std::max(m_litEnd[uy], ux + 1);
+            markDirty(uy);
+        }
+    }
+}
+
+void GoniometerVisualizer::draw(RenderSurface &surface)
+{
+    if (!m_image || m_imageSurface != &surface)
+    {
+        m_image = surface.createImage({m_side, m_side});
+        m_imageSurface = &surface;
+        m_fullUpload = true;
+        if (!m_image)
+            return;
+    }
+    if (m_fullUpload)
+    {
+        m_image->update(m_pixels.data());
+        m_fullUpload = false;
+    }
+    else if (m_dirtyBegin < m_dirtyEnd)
+    {
+        // Whole rows, so the block is contiguous in m_pixels
+        m_image->update(&m_pixels[static_cast<std::size_t>(m_dirtyBegin) * m_side * 4],
+                        {m_side, m_dirtyEnd - m_dirtyBegin}, {0, m_dirtyBegin});
+    }
+    m_dirtyBegin = m_dirtyEnd = 0;
+
+    // Centered square
+    const float side = static_cast<float>(m_side);
+    surface.drawImage(*m_image, sf::FloatRect({(m_width - side) * 0.5f, (m_height - side) * 0.5f}, {side, side}));
+}
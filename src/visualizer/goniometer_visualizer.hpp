@@ -0,0 +1,67 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "color_gradient.hpp"
+#include "visualizer_base.hpp"
+
+// Stereo XY scope (goniometer): every left/right sample pair is a point, so
+// mono content draws a line, wide content a cloud and out-of-phase content a
+// line across the other axis.
+//
+// Points are splatted into a square CPU intensity buffer that fades with a
+// persistence time constant; the buffer is colored through the gradient LUT
+// and uploaded as one image, so cost doesn't grow with the number of
+// primitives. Each row tracks the span that is still lit, and only those
+// spans are faded, recolored and uploaded.
+class GoniometerVisualizer : public VisualizerBase
+{
+public:
+    GoniometerVisualizer(float width, float height);
+
+    void update(const AnalysisFrame &frame, float dt) override;
+    void draw(RenderSurface &surface) override;
+    void resize(float width, float height) override;
+
+    AnalysisRequirements requirements() const override;
+
+    // true: mid up, side across (the usual goniometer view, mono is vertical).
+    // false: raw L on x, R on y (Lissajous, mono is diagonal).
+    void setMidSide(bool enabled) { m_midSide = enabled; }
+
+    // Seconds for a trace to fade to ~37%
+    void setPersistence(float seconds) { m_persistence = std::max(seconds, 1e-3f); }
+
+    void setGradient(const ColorGradient &gradient) { m_gradient = gradient; }
+
+private:
+    float m_width;
+    float m_height;
+    unsigned int m_side = 0; // Buffer and image are m_side x m_side
+
+    std::vector<float> m_intensity;     // Row-major, 0 = dark
+    std::vector<std::uint8_t> m_pixels; // RGBA staging for the upload
+    std::uint64_t m_lastSequence = 0;
+
+    // Per row, the columns [begin, end) that may be non-zero; empty when equal
+    std::vector<unsigned int> m_litBegin;
+    std::vector<unsigned int> m_litEnd;
+
+    // Rows [begin, end) of m_pixels changed since the last upload
+    unsigned int m_dirtyBegin = 0;
+    unsigned int m_dirtyEnd = 0;
+    bool m_fullUpload = true; // The image is new and needs every row
+
+    bool m_midSide = true;
+    float m_persistence = 0.15f;
+
+    std::unique_ptr<SurfaceImage> m_image;
+    const RenderSurface *m_imageSurface = nullptr; // Surface m_image belongs to
+
+    ColorGradient m_gradient;
+
+    void setupBuffer();
+    void colorPixel(std::size_t index);
+    void markDirty(unsigned int row);
+};
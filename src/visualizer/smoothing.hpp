@@ -0,0 +1,14 @@
+#pragma once
+
+// Levels below this snap to rest: far below a pixel at any window height,
+// and it stops the exponential decay before values turn denormal, which
+// makes every later step through them many times slower
+constexpr float REST_LEVEL = 1e-6f;
+
+// One step of exponential smoothing from `current` towards `target`, where
+// coef is the fraction of the distance covered this frame
+inline float smoothLevel(float current, float target, float coef)
+{
+    float next = current + (target - current) * coef;
+    return next < REST_LEVEL ? 0.0f : next;
+}
@@ -0,0 +1,129 @@
+#include "spectrogram_visualizer.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    // Upper bound on frequency rows; tall windows stretch the image
+    constexpr unsigned int MAX_BANDS = 512;
+}
+
+SpectrogramVisualizer::SpectrogramVisualizer(float width, float height)
+    : m_width(width), m_height(height)
+{
+    setupHistory();
+}
+
+void SpectrogramVisualizer::setupHistory()
+{
+    m_columns = std::max(1u, static_cast<unsigned int>(m_width));
+    m_bands = std::clamp(static_cast<unsigned int>(m_height), 1u, MAX_BANDS);
+
+    m_history.assign(static_cast<std::size_t>(m_columns) * m_bands, 0.0f);
+    m_pixels.assign(m_history.size() * 4, 0);
+    m_levels.assign(m_bands, 0.0f);
+    m_head = 0;
+    m_pending = 0;
+
+    // Recreated at the new size on the next draw
+    m_image.reset();
+    m_imageSurface = nullptr;
+}
+
+void SpectrogramVisualizer::uploadColumn(unsigned int column)
+{
+    m_image->update(&m_pixels[static_cast<std::size_t>(column) * m_bands * 4], {1, m_bands}, {column, 0});
+}
+
+AnalysisRequirements SpectrogramVisualizer::requirements() const
+{
+    AnalysisRequirements requirements;
+    requirements.products = ANALYSIS_SPECTRUM;
+    return requirements;
+}
+
+void SpectrogramVisualizer::resize(float width, float height)
+{
+    m_width = width;
+    m_height = height;
+    setupHistory();
+}
+
+void SpectrogramVisualizer::update(const AnalysisFrame &frame, float)
+{
+    // One column per STFT hop, however often we're called, so the view
+    // scrolls in audio time at any frame rate
+    const size_t hops = frame.hopSequences.size();
+    if (hops == 0 || frame.hopSpectra.size() % hops != 0)
+        return;
+
+    const size_t binCount = frame.hopSpectra.size() / hops;
+    int fftSize = (static_cast<int>(binCount) - 1) * 2;
+    m_mapping.configure(static_cast<int>(m_bands), fftSize, m_sampleRate);
+
+    for (size_t h = 0; h < hops; ++h)
+    {
+        if (frame.hopSequences[h] <= m_lastSequence)
+            continue;
+        m_lastSequence = frame.hopSequences[h];
+        writeColumn(frame.hopSpectra.data() + h * binCount);
+    }
+}
+
+void SpectrogramVisualizer::writeColumn(const float *bins)
+{
+    m_mapping.apply(bins, BandAggregate::Max, m_levels.data());
+
+    float *row = &m_history[static_cast<std::size_t>(m_head) * m_bands];
+    for (unsigned int i = 0; i < m_bands; ++i)
+        row[i] = std::clamp(m_levels[i] * 2.0f, 0.0f, 1.0f);
+
+    // Image rows run top-down, so the lowest band goes in the last row.
+    // Quiet bins fade out rather than painting the gradient's base color.
+    std::uint8_t *pixel = &m_pixels[static_cast<std::size_t>(m_head) * m_bands * 4];
+    for (unsigned int i = 0; i < m_bands; ++i, pixel += 4)
+    {
+        float level = row[m_bands - 1 - i];
+        sf::Color color = m_gradient[ColorGradient::indexOf(level)];
+        pixel[0] = color.r;
+        pixel[1] = color.g;
+        pixel[2] = color.b;
+        pixel[3] = static_cast<std::uint8_t>(color.a * level);
+    }
+
+    m_head = (m_head + 1) % m_columns;
+    m_pending = std::min(m_pending + 1, m_columns);
+}
+
+void SpectrogramVisualizer::exportHistory(std::vector<float> &out) const
+{
+    // Oldest first: the tail of the ring from m_head, then its start
+    const std::size_t split = static_cast<std::size_t>(m_head) * m_bands;
+    out.resize(m_history.size());
+    std::memcpy(out.data(), m_history.data() + split, (m_history.size() - split) * sizeof(float));
+    std::memcpy(out.data() + (m_history.size() - split), m_history.data(), split * sizeof(float));
+}
+
+void SpectrogramVisualizer::draw(RenderSurface &surface)
+{
+    // A new image (first draw, resize or another surface) gets every column;
+    // after that only the ones written since the last draw go up
+    if (!m_image || m_imageSurface != &surface)
+    {
+        m_image = surface.createImage({m_columns, m_bands});
+        m_imageSurface = &surface;
+        if (!m_image)
+            return;
+        for (unsigned int column = 0; column < m_columns; ++column)
+            uploadColumn(column);
+    }
+    else
+    {
+        for (unsigned int i = m_pending; i > 0; --i)
+            uploadColumn((m_head + m_columns - i) % m_columns);
+    }
+    m_pending = 0;
+
+    // Start at the oldest column; the image wraps back around to the newest
+    surface.drawImage(*m_image, sf::FloatRect({0.0f, 0.0f}, {m_width, m_height}), static_cast<float>(m_head));
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+#include "bar_mapping.hpp"
+#include "color_gradient.hpp"
+#include "visualizer_base.hpp"
+
+// Scrolling spectrogram: time runs left to right, frequency (log-spaced)
+// bottom to top, one pixel column per STFT hop (AnalysisFrame::hopSpectra).
+//
+// The surface image is used as a ring: each new spectrum overwrites only the
+// oldest column with a one-column update, and the view scrolls by drawing
+// the image with a wrapping horizontal offset, so nothing else is ever
+// re-uploaded. The same history is kept on the CPU as a contiguous ring of
+// band rows for export.
+class SpectrogramVisualizer : public VisualizerBase
+{
+public:
+    SpectrogramVisualizer(float width, float height);
+
+    void update(const AnalysisFrame &frame, float dt) override;
+    void draw(RenderSurface &surface) override;
+    void resize(float width, float height) override;
+
+    AnalysisRequirements requirements() const override;
+
+    // Needed to place the log-spaced bands; defaults to 44.1 kHz
+    void setSampleRate(unsigned int sampleRate) { m_sampleRate = sampleRate; }
+    void setGradient(const ColorGradient &gradient) { m_gradient = gradient; }
+
+    unsigned int columns() const { return m_columns; }
+    unsigned int bands() const { return m_bands; }
+
+    // Copies the history oldest column first, as columns() rows of bands()
+    // values in 0..1 with the lowest band first
+    void exportHistory(std::vector<float> &out) const;
+
+private:
+    float m_width;
+    float m_height;
+    unsigned int m_columns = 0; // History length = texture width
+    unsigned int m_bands = 0;   // Texture height
+
+    std::vector<float> m_history;       // m_columns x m_bands, row per spectrum
+    std::vector<std::uint8_t> m_pixels; // RGBA, stored column by column so each is one upload
+    std::vector<float> m_levels;        // Band values of the newest spectrum
+    unsigned int m_head = 0;            // Next column to overwrite (= oldest)
+    unsigned int m_pending = 0;         // Columns written since the last upload
+    std::uint64_t m_lastSequence = 0;  // Window end of the newest column written
+
+    std::unique_ptr<SurfaceImage> m_image;
+    const RenderSurface *m_imageSurface = nullptr; // Surface m_image belongs to
+
+    unsigned int m_sampleRate = 44100;
+    BarMapping m_mapping;
+    ColorGradient m_gradient;
+
+    void setupHistory();
+    void writeColumn(const float *bins); // Overwrites the oldest column with one hop
+    void uploadColumn(unsigned int column);
+};
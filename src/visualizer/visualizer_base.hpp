@@ -0,0 +1,43 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <functional>
+#include "audio/analysis_frame.hpp"
+#include "render/render_surface.hpp"
+
+// Common interface for everything the render loop can draw.
+//
+// Each visualizer declares the analysis products it consumes; the pipeline
+// computes only those, so e.g. a waveform view never pays for an FFT.
+class VisualizerBase
+{
+public:
+    virtual ~VisualizerBase() = default;
+
+    // frame: newest analysis result (only the products in frame.products are
+    // filled in; none before the first frame arrives)
+    // dt: real seconds since the previous update
+    virtual void update(const AnalysisFrame &frame, float dt) = 0;
+
+    // Drawing goes through RenderSurface, so the same visualizer renders to
+    // the window or headlessly into a CPU framebuffer
+    virtual void draw(RenderSurface &surface) = 0;
+    virtual void resize(float width, float height) = 0;
+
+    virtual AnalysisRequirements requirements() const = 0;
+
+    // Called with the new requirements whenever they change after creation
+    // (e.g. a resize changes the waveform's column count), so the owner can
+    // pass them on to the analysis thread
+    using RequirementsListener = std::function<void(const AnalysisRequirements &)>;
+    void setRequirementsListener(RequirementsListener listener) { m_requirementsListener = std::move(listener); }
+
+protected:
+    void publishRequirements()
+    {
+        if (m_requirementsListener)
+            m_requirementsListener(requirements());
+    }
+
+private:
+    RequirementsListener m_requirementsListener;
+};
@@ -0,0 +1,83 @@
+#include "visualizer_registry.hpp"
+#include <algorithm>
+#include "bar_visualizer.hpp"
+#include "circular_visualizer.hpp"
+#include "goniometer_visualizer.hpp"
+#include "spectrogram_visualizer.hpp"
+#include "wave_visualizer.hpp"
+#include "core/config.hpp"
+
+VisualizerRegistry VisualizerRegistry::withBuiltins()
+{
+    VisualizerRegistry registry;
+
+    registry.add("bars", [](const VisualizerContext &context)
+    {
+        auto bars = std::make_unique<BarVisualizer>(context.config.visualizer.barCount, context.width, context.height);
+        bars->setSampleRate(context.sampleRate);
+        bars->setGradient(ColorGradient(context.config.visualizer.gradient));
+        return bars;
+    });
+
+    registry.add("circular", [](const VisualizerContext &context)
+    {
+        auto circular = std::make_unique<CircularVisualizer>(context.config.visualizer.barCount, context.width, context.height);
+        circular->setSampleRate(context.sampleRate);
+        circular->setGradient(ColorGradient(context.config.visualizer.gradient));
+        return circular;
+    });
+
+    registry.add("spectrogram", [](const VisualizerContext &context)
+    {
+        auto spectrogram = std::make_unique<SpectrogramVisualizer>(context.width, context.height);
+        spectrogram->setSampleRate(context.sampleRate);
+        spectrogram->setGradient(ColorGradient(context.config.visualizer.gradient));
+        return spectrogram;
+    });
+
+    registry.add("wave", [](const VisualizerContext &context)
+    {
+        auto wave = std::make_unique<WaveVisualizer>(context.width, context.height, context.config.visualizer.waveSeconds);
+        wave->setGradient(ColorGradient(context.config.visualizer.gradient));
+        wave->setTrigger(context.config.visualizer.waveTrigger);
+        return wave;
+    });
+
+    registry.add("goniometer", [](const VisualizerContext &context)
+    {
+        auto goniometer = std::make_unique<GoniometerVisualizer>(context.width, context.height);
+        goniometer->setGradient(ColorGradient(context.config.visualizer.gradient));
+        return goniometer;
+    });
+
+    return registry;
+}
+
+void VisualizerRegistry::add(const std::string &name, Factory factory)
+{
+    auto it = std::find(m_names.begin(), m_names.end(), name);
+    if (it != m_names.end())
+    {
+        m_factories[it - m_names.begin()] = std::move(factory);
+        return;
+    }
+
+    m_names.push_back(name);
+    m_factories.push_back(std::move(factory));
+}
+
+std::unique_ptr<VisualizerBase> VisualizerRegistry::create(const std::string &name, const VisualizerContext &context) const
+{
+    auto it = std::find(m_names.begin(), m_names.end(), name);
+    if (it == m_names.end())
+        return nullptr;
+    return m_factories[it - m_names.begin()](context);
+}
+
+const std::string &VisualizerRegistry::next(const std::string &name) const
+{
+    auto it = std::find(m_names.begin(), m_names.end(), name);
+    if (it == m_names.end() || ++it == m_names.end())
+        return m_names.front();
+    return *it;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "visualizer_base.hpp"
+
+struct Config;
+
+// What a factory gets to build a visualizer with
+struct VisualizerContext
+{
+    float width;
+    float height;
+    unsigned int sampleRate;
+    const Config &config;
+};
+
+// Name -> factory table used to pick and switch visualizers at runtime
+class VisualizerRegistry
+{
+public:
+    using Factory = std::function<std::unique_ptr<VisualizerBase>(const VisualizerContext &)>;
+
+    // Registry holding every visualizer shipped with the app
+    static VisualizerRegistry withBuiltins();
+
+    void add(const std::string &name, Factory factory);
+
+    // Returns nullptr for unknown names
+    std::unique_ptr<VisualizerBase> create(const std::string &name, const VisualizerContext &context) const;
+
+    const std::vector<std::string> &names() const { return m_names; }
+
+    // The name registered after `name`, wrapping around (first name if unknown)
+    const std::string &next(const std::string &name) const;
+
+private:
+    std::vector<std::string> m_names;
+    std::vector<Factory> m_factories;
+};
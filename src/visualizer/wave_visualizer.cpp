@@ -0,0 +1,90 @@
+#include "wave_visualizer.hpp"
+#include <algorithm>
+#include <cmath>
+
+WaveVisualizer::WaveVisualizer(float width, float height, float seconds)
+    : m_width(width), m_height(height), m_seconds(seconds)
+{
+    setupColumns();
+}
+
+void WaveVisualizer::setupColumns()
+{
+    m_columns = std::max(1u, static_cast<unsigned int>(m_width));
+    m_vertices.setPrimitiveType(sf::PrimitiveType::LineStrip);
+    m_vertices.resize(static_cast<std::size_t>(m_columns) * 2);
+
+    // Flat line until the first frame arrives
+    for (unsigned int c = 0; c < m_columns; ++c)
+    {
+        float x = static_cast<float>(c) + 0.5f;
+        m_vertices[c * 2].position = {x, m_height * 0.5f};
+        m_vertices[c * 2 + 1].position = {x, m_height * 0.5f};
+        m_vertices[c * 2].color = m_gradient.at(0.0f);
+        m_vertices[c * 2 + 1].color = m_gradient.at(0.0f);
+    }
+}
+
+void WaveVisualizer::resize(float width, float height)
+{
+    m_width = width;
+    m_height = height;
+    setupColumns();
+
+    // One min/max pair per column: the worker must decimate to the new width
+    publishRequirements();
+}
+
+void WaveVisualizer::setSeconds(float seconds)
+{
+    m_seconds = seconds;
+    publishRequirements();
+}
+
+void WaveVisualizer::setTrigger(bool enabled)
+{
+    m_trigger = enabled;
+    publishRequirements();
+}
+
+AnalysisRequirements WaveVisualizer::requirements() const
+{
+    AnalysisRequirements requirements;
+    requirements.products = ANALYSIS_WAVEFORM;
+    requirements.waveformColumns = m_columns;
+    requirements.waveformSeconds = m_seconds;
+    requirements.waveformTrigger = m_trigger;
+    return requirements;
+}
+
+void WaveVisualizer::update(const AnalysisFrame &frame, float)
+{
+    if (!(frame.products & ANALYSIS_WAVEFORM) || frame.waveMin.size() != m_columns)
+        return;
+
+    const float mid = m_height * 0.5f;
+    const float scale = m_height * 0.45f;
+
+    for (unsigned int c = 0; c < m_columns; ++c)
+    {
+        float lo = std::clamp(frame.waveMin[c], -1.0f, 1.0f);
+        float hi = std::clamp(frame.waveMax[c], -1.0f, 1.0f);
+
+        // Alternate the vertex order so consecutive columns join at the same
+        // extreme and the strip stays a clean trace rather than a sawtooth
+        float first = (c & 1) ? hi : lo;
+        float second = (c & 1) ? lo : hi;
+        sf::Color color = m_gradient.at(std::max(std::fabs(lo), std::fabs(hi)));
+
+        sf::Vertex *pair = &m_vertices[c * 2];
+        pair[0].position.y = mid - first * scale;
+        pair[1].position.y = mid - second * scale;
+        pair[0].color = color;
+        pair[1].color = color;
+    }
+}
+
+void WaveVisualizer::draw(RenderSurface &surface)
+{
+    surface.drawVertices(&m_vertices[0], m_vertices.getVertexCount(), sf::PrimitiveType::LineStrip);
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "color_gradient.hpp"
+#include "visualizer_base.hpp"
+
+// Oscilloscope-style view of the last few seconds of audio.
+//
+// The analysis thread decimates the capture history into one min/max pair per
+// pixel column, so drawing costs O(width) whatever the span or sample rate.
+// Each column becomes a vertical segment of a single line strip.
+//
+// With the trigger on, the span starts on a rising zero crossing instead of
+// ending at the newest sample, so periodic signals stand still on screen.
+class WaveVisualizer : public VisualizerBase
+{
+public:
+    WaveVisualizer(float width, float height, float seconds = 2.0f);
+
+    void update(const AnalysisFrame &frame, float dt) override;
+    void draw(RenderSurface &surface) override;
+    void resize(float width, float height) override;
+
+    AnalysisRequirements requirements() const override;
+
+    void setSeconds(float seconds);
+    void setTrigger(bool enabled);
+    void setGradient(const ColorGradient &gradient) { m_gradient = gradient; }
+
+private:
+    float m_width;
+    float m_height;
+    float m_seconds;
+    bool m_trigger = false;
+    unsigned int m_columns = 0;
+
+    ColorGradient m_gradient;
+    sf::VertexArray m_vertices; // 2 per column, zig-zagging min/max
+
+    void setupColumns();
+};
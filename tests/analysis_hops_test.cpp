@@ -0,0 +1,89 @@
+// Polls the analysis thread more slowly than it produces STFT hops and checks
+// that every hop still reaches the renderer exactly once, in order, and is
+// folded into the frame's bins.
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include "audio/analysis_thread.hpp"
+#include "audio/synthetic_source.hpp"
+
+namespace
+{
+    constexpr int FFT_SIZE = 1024;                          // Hop of 512 at 50% overlap
+    constexpr auto POLL_INTERVAL = std::chrono::milliseconds(30); // ~2.6 hops per poll at 44.1 kHz
+    constexpr float SECONDS = 0.6f;
+}
+
+int main()
+{
+    SignalSpec spec;
+    spec.kind = SignalKind::Sweep;
+    spec.seconds = SECONDS;
+    SyntheticSource source(spec, SourcePacing::Realtime);
+    if (!source.init())
+        return 1;
+
+    AnalysisThread analysis(source, FFT_SIZE);
+    AnalysisRequirements requirements;
+    requirements.products = ANALYSIS_SPECTRUM;
+    analysis.setRequirements(requirements);
+    analysis.start();
+
+    const uint64_t hop = FFT_SIZE / 2;
+    const size_t binCount = FFT_SIZE / 2 + 1;
+    uint64_t expected = FFT_SIZE; // First window ends once N samples are in
+    uint64_t received = 0;
+    int failures = 0;
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<float>(SECONDS + 0.2f);
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(POLL_INTERVAL);
+        analysis.poll();
+        const AnalysisFrame &frame = analysis.latest();
+
+        if (frame.hopSpectra.size() != frame.hopSequences.size() * binCount)
+        {
+            std::fprintf(stderr, "[FAIL] %zu spectrum values for %zu hops\n", frame.hopSpectra.size(), frame.hopSequences.size());
+            failures++;
+        }
+        // bins must hold the loudest value each bin reached in any of them
+        for (size_t i = 0; i < binCount && !frame.hopSequences.empty(); ++i)
+        {
+            float loudest = 0.0f;
+            for (size_t h = 0; h < frame.hopSequences.size(); ++h)
+                loudest = std::max(loudest, frame.hopSpectra[h * binCount + i]);
+            if (frame.bins.size() != binCount || frame.bins[i] != loudest)
+            {
+                std::fprintf(stderr, "[FAIL] bin %zu is not the maximum over the frame's hops\n", i);
+                failures++;
+                break;
+            }
+        }
+
+        for (uint64_t end : frame.hopSequences)
+        {
+            if (end != expected)
+            {
+                std::fprintf(stderr, "[FAIL] hop ending at %llu, expected %llu\n", (unsigned long long)end,
+                             (unsigned long long)expected);
+                failures++;
+            }
+            expected = end + hop;
+            received++;
+        }
+    }
+    analysis.stop();
+
+    const uint64_t produced = (uint64_t)(SECONDS * spec.sampleRate);
+    const uint64_t total = produced >= (uint64_t)FFT_SIZE ? (produced - FFT_SIZE) / hop + 1 : 0;
+    std::printf("%llu of %llu hops received, %llu dropped\n", (unsigned long long)received, (unsigned long long)total,
+                (unsigned long long)analysis.hopsDropped());
+    if (received != total || analysis.hopsDropped() != 0)
+    {
+        std::fprintf(stderr, "[FAIL] not every hop was delivered\n");
+        failures++;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,132 @@
+// Checks the real-input FFT path against a naive DFT computed in double:
+// kiss_fftr's raw N/2 + 1 bins, and the dB bins FftProcessor produces from
+// them, for a few sizes and a signal mixing tones, DC and noise.
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "audio/fft_processor.hpp"
+
+namespace
+{
+    constexpr double PI = 3.14159265358979323846;
+    constexpr double MAX_RELATIVE_ERROR = 1e-5; // Raw bins, relative to the peak
+    constexpr double MAX_ERROR_DB = 1e-3;       // FftProcessor output
+    const int SIZES[] = {64, 512, 1024, 4096};
+
+    std::vector<float> testSignal(int n)
+    {
+        std::vector<float> signal(n);
+        std::uint32_t state = 777;
+        for (int i = 0; i < n; ++i)
+        {
+            state = state * 1664525u + 1013904223u;
+            double noise = (state >> 8) / 16777216.0 - 0.5;
+            signal[i] = (float)(0.1 + 0.5 * std::sin(2.0 * PI * 37.3 * i / n) + 0.25 * std::cos(2.0 * PI * (n / 5) * i / n) +
+                                0.05 * noise);
+        }
+        return signal;
+    }
+
+    // X[k] = sum x[i] e^(-2 pi j k i / N) for k = 0 .. N/2
+    std::vector<std::complex<double>> naiveDft(const std::vector<double> &x)
+    {
+        const size_t n = x.size();
+        std::vector<double> cosTable(n), sinTable(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            cosTable[i] = std::cos(2.0 * PI * i / n);
+            sinTable[i] = std::sin(2.0 * PI * i / n);
+        }
+
+        std::vector<std::complex<double>> bins(n / 2 + 1);
+        for (size_t k = 0; k <= n / 2; ++k)
+        {
+            double re = 0.0, im = 0.0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                size_t phase = (k * i) % n;
+                re += x[i] * cosTable[phase];
+                im -= x[i] * sinTable[phase];
+            }
+            bins[k] = {re, im};
+        }
+        return bins;
+    }
+
+    bool checkRawBins(int n, const std::vector<float> &signal)
+    {
+        std::vector<double> input(signal.begin(), signal.end());
+        std::vector<std::complex<double>> expected = naiveDft(input);
+
+        kiss_fftr_cfg cfg = kiss_fftr_alloc(n, 0, NULL, NULL);
+        std::vector<kiss_fft_cpx> out(n / 2 + 1);
+        kiss_fftr(cfg, signal.data(), out.data());
+        kiss_fftr_free(cfg);
+
+        double peak = 0.0, worst = 0.0;
+        for (const auto &bin : expected)
+            peak = std::max(peak, std::abs(bin));
+        for (size_t k = 0; k < expected.size(); ++k)
+            worst = std::max(worst, std::abs(std::complex<double>(out[k].r, out[k].i) - expected[k]) / peak);
+
+        std::printf("N = %5d  kiss_fftr      max error %.2e of peak\n", n, worst);
+        if (!(worst <= MAX_RELATIVE_ERROR))
+        {
+            std::fprintf(stderr, "[FAIL] kiss_fftr at N = %d misses the %.0e bound\n", n, MAX_RELATIVE_ERROR);
+            return false;
+        }
+        return true;
+    }
+
+    bool checkProcessor(int n, const std::vector<float> &signal)
+    {
+        // Same Hann window and scaling as FftProcessor, in double
+        std::vector<double> windowed(n);
+        for (int i = 0; i < n; ++i)
+            windowed[i] = signal[i] * 0.5 * (1.0 - std::cos(2.0 * PI * i / (n - 1)));
+        std::vector<std::complex<double>> expected = naiveDft(windowed);
+
+        FftProcessor fft(n);
+        AudioSnapshot snapshot;
+        snapshot.data = signal.data();
+        snapshot.count = signal.size();
+        snapshot.sequence = signal.size();
+        std::vector<float> bars;
+        if (!fft.calculate(snapshot, bars) || bars.size() != expected.size())
+        {
+            std::fprintf(stderr, "[FAIL] FftProcessor at N = %d returned %zu bins, expected %zu\n", n, bars.size(),
+                         expected.size());
+            return false;
+        }
+
+        double worst = 0.0;
+        for (size_t k = 0; k < expected.size(); ++k)
+        {
+            double db = 20.0 * std::log10(std::abs(expected[k]) + 1.0);
+            worst = std::max(worst, std::fabs(bars[k] * 60.0 - db));
+        }
+
+        std::printf("N = %5d  FftProcessor   max error %.2e dB\n", n, worst);
+        if (!(worst <= MAX_ERROR_DB))
+        {
+            std::fprintf(stderr, "[FAIL] FftProcessor at N = %d misses the %.0e dB bound\n", n, MAX_ERROR_DB);
+            return false;
+        }
+        return true;
+    }
+}
+
+int main()
+{
+    bool ok = true;
+    for (int n : SIZES)
+    {
+        std::vector<float> signal = testSignal(n);
+        ok = checkRawBins(n, signal) && ok;
+        ok = checkProcessor(n, signal) && ok;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,114 @@
+// The goniometer splats each stereo pair once, keyed by sample sequence:
+// frames that overlap (each carries the latest pairs ending at its sequence)
+// or that the renderer sees twice must draw exactly what frames carrying only
+// the new pairs would. Once the audio stops, the trace fades to nothing.
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include "render/software_surface.hpp"
+#include "visualizer/goniometer_visualizer.hpp"
+
+namespace
+{
+    constexpr unsigned int SIZE = 240;
+    constexpr unsigned int SAMPLE_RATE = 44100;
+    constexpr std::uint64_t FRAME_SAMPLES = SAMPLE_RATE / 60;
+    constexpr size_t OVERLAP_PAIRS = 4096; // What the analysis thread attaches
+    constexpr int FRAMES = 90;
+    constexpr float DT = 1.0f / 60.0f;
+    const sf::Color BACKGROUND(10, 10, 20, 255);
+
+    // Pair n of a slowly rotating, slightly noisy figure
+    void pair(std::uint64_t n, float &left, float &right)
+    {
+        double t = (double)n / SAMPLE_RATE;
+        std::uint32_t hash = (std::uint32_t)(n * 2654435761u);
+        float noise = ((hash >> 8) / 16777216.0f - 0.5f) * 0.05f;
+        left = (float)(0.7 * std::sin(2.0 * 3.14159265358979 * 310.0 * t)) + noise;
+        right = (float)(0.6 * std::sin(2.0 * 3.14159265358979 * 310.0 * t + 0.5 + t)) - noise;
+    }
+
+    // Stereo frame ending at `sequence` holding pairs [sequence - count, sequence)
+    AnalysisFrame stereoFrame(std::uint64_t sequence, size_t count)
+    {
+        AnalysisFrame frame;
+        frame.products = ANALYSIS_STEREO;
+        frame.sequence = sequence;
+        frame.stereoLeft.resize(count);
+        frame.stereoRight.resize(count);
+        for (size_t i = 0; i < count; ++i)
+            pair(sequence - count + i, frame.stereoLeft[i], frame.stereoRight[i]);
+        return frame;
+    }
+
+    void render(GoniometerVisualizer &scope, SoftwareSurface &surface)
+    {
+        surface.clear(BACKGROUND);
+        scope.draw(surface);
+    }
+
+    size_t differingPixels(const SoftwareSurface &a, const SoftwareSurface &b)
+    {
+        size_t differing = 0;
+        for (unsigned int y = 0; y < SIZE; ++y)
+            for (unsigned int x = 0; x < SIZE; ++x)
+                differing += a.pixel(x, y) != b.pixel(x, y);
+        return differing;
+    }
+}
+
+int main()
+{
+    GoniometerVisualizer overlapping(SIZE, SIZE);
+    GoniometerVisualizer exact(SIZE, SIZE);
+    SoftwareSurface overlappingSurface(SIZE, SIZE);
+    SoftwareSurface exactSurface(SIZE, SIZE);
+
+    int failures = 0;
+    size_t lit = 0;
+    std::uint64_t sequence = OVERLAP_PAIRS;
+    for (int f = 0; f < FRAMES; ++f)
+    {
+        sequence += FRAME_SAMPLES;
+        overlapping.update(stereoFrame(sequence, OVERLAP_PAIRS), DT);
+        exact.update(stereoFrame(sequence, f == 0 ? OVERLAP_PAIRS : FRAME_SAMPLES), DT);
+
+        // Every fourth frame the renderer presents again before a new
+        // analysis frame arrives: same frame, time still passes
+        if (f % 4 == 3)
+        {
+            overlapping.update(stereoFrame(sequence, OVERLAP_PAIRS), DT);
+            exact.update(AnalysisFrame(), DT);
+        }
+
+        render(overlapping, overlappingSurface);
+        render(exact, exactSurface);
+        size_t differing = differingPixels(overlappingSurface, exactSurface);
+        if (differing > 0 && failures++ < 5)
+            std::fprintf(stderr, "[FAIL] frame %d: %zu pixels differ from drawing each pair once\n", f, differing);
+    }
+
+    SoftwareSurface blank(SIZE, SIZE);
+    blank.clear(BACKGROUND);
+    lit = differingPixels(overlappingSurface, blank);
+    if (lit == 0)
+    {
+        std::fprintf(stderr, "[FAIL] the trace never showed\n");
+        failures++;
+    }
+
+    // Silence: frames with no new pairs, for far longer than the persistence
+    for (int f = 0; f < 120; ++f)
+    {
+        overlapping.update(stereoFrame(sequence, OVERLAP_PAIRS), DT);
+        render(overlapping, overlappingSurface);
+    }
+    size_t left = differingPixels(overlappingSurface, blank);
+    std::printf("goniometer: %zu pixels lit, %zu still lit after 2 s of silence\n", lit, left);
+    if (left > 0)
+    {
+        std::fprintf(stderr, "[FAIL] %zu pixels never faded out\n", left);
+        failures++;
+    }
+    return failures == 0 ? 0 : 1;
+}
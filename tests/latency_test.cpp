@@ -0,0 +1,143 @@
+// End-to-end latency check: a train of impulses from the synthetic source
+// goes through the real capture handoff, analysis thread and bar visualizer
+// (drawn into a SoftwareSurface at 60 fps). Each impulse is timed from the
+// moment it was "played" to the first drawn frame whose spectrum shows it,
+// and the p99 must stay under MAX_P99_SECONDS.
+//
+// There's no real window, so buffer swaps and vsync aren't included; the live
+// --latency report times actual presents.
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+#include "audio/analysis_thread.hpp"
+#include "audio/synthetic_source.hpp"
+#include "core/latency_histogram.hpp"
+#include "render/software_surface.hpp"
+#include "visualizer/bar_visualizer.hpp"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr float SECONDS = 4.0f;
+    constexpr float IMPULSE_RATE = 4.0f;    // Impulses per second; far apart next to any FFT window
+    constexpr float VISIBLE_LEVEL = 0.001f; // Bin level that counts as "shows the impulse"
+    constexpr double FRAME_RATE = 60.0;
+    constexpr int FFT_SIZE = 1024;
+    constexpr int BAR_COUNT = 64;
+    constexpr unsigned int WIDTH = 800;
+    constexpr unsigned int HEIGHT = 400;
+
+    // One hop, one source block and one frame period, with room for a loaded machine
+    constexpr double MAX_P99_SECONDS = 0.1;
+
+    float loudestBin(const AnalysisFrame &frame)
+    {
+        return frame.bins.empty() ? 0.0f : *std::max_element(frame.bins.begin(), frame.bins.end());
+    }
+}
+
+int main()
+{
+    SignalSpec signal;
+    signal.kind = SignalKind::Impulses;
+    signal.rate = IMPULSE_RATE;
+    signal.amplitude = 1.0f;
+    signal.seconds = SECONDS;
+    SyntheticSource source(signal, SourcePacing::Realtime);
+    if (!source.init())
+    {
+        std::fprintf(stderr, "[FAIL] synthetic source did not start\n");
+        return 1;
+    }
+    const unsigned int sampleRate = source.sampleRate();
+    const uint64_t period = (uint64_t)(sampleRate / IMPULSE_RATE + 0.5f);
+
+    BarVisualizer bars(BAR_COUNT, (float)WIDTH, (float)HEIGHT);
+    bars.setSampleRate(sampleRate);
+
+    AnalysisThread analysis(source, FFT_SIZE);
+    analysis.setRequirements(bars.requirements());
+    analysis.start();
+
+    SoftwareSurface surface(WIDTH, HEIGHT);
+    PipelineLatency pipeline;
+    LatencyHistogram impulses;
+    // Sequence of the next impulse not yet seen on screen. The one at sample 0
+    // only ever sits at the tapered edge of the first window, so start at the second.
+    uint64_t nextImpulse = period;
+    uint64_t missed = 0;
+
+    const auto frameTime = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / FRAME_RATE));
+    auto deadline = Clock::now();
+    auto previous = deadline;
+
+    while (!source.finished())
+    {
+        deadline += frameTime;
+        std::this_thread::sleep_until(deadline);
+
+        bool fresh = analysis.poll();
+        const AnalysisFrame &frame = analysis.latest();
+        auto now = Clock::now();
+        bars.update(frame, std::chrono::duration<float>(now - previous).count());
+        previous = now;
+        surface.clear(sf::Color::Black);
+        bars.draw(surface);
+        const auto presentedAt = Clock::now();
+
+        pipeline.record(frame, presentedAt);
+        if (!fresh || frame.capturedAt == Clock::time_point{})
+            continue;
+
+        // Impulses that already left every window this frame covers without
+        // showing. bins folds in all hops since the last present, so only a
+        // stall long enough to overflow the hop queue should leave any.
+        const uint64_t oldestEnd = frame.hopSequences.empty() ? frame.sequence : frame.hopSequences.front();
+        const uint64_t windowStart = oldestEnd > (uint64_t)FFT_SIZE ? oldestEnd - FFT_SIZE : 0;
+        while (nextImpulse < windowStart)
+        {
+            missed++;
+            nextImpulse += period;
+        }
+
+        if (frame.sequence > nextImpulse && loudestBin(frame) >= VISIBLE_LEVEL)
+        {
+            // The source releases audio at the sample rate, so the impulse
+            // was played this long before the newest analyzed sample arrived
+            std::chrono::duration<double> age((frame.sequence - 1 - nextImpulse) / (double)sampleRate);
+            auto playedAt = frame.capturedAt - std::chrono::duration_cast<Clock::duration>(age);
+            impulses.add(std::chrono::duration<double>(presentedAt - playedAt).count());
+            nextImpulse += period;
+        }
+    }
+
+    analysis.stop();
+
+    pipeline.report(std::cout);
+    std::cout << "[INFO] Impulses shown: " << impulses.count() << ", skipped by the renderer: " << missed << std::endl;
+    impulses.print(std::cout, "impulse -> drawn");
+
+    // Every impulse but the skipped first one and the one at the very end
+    const uint64_t expected = (uint64_t)(SECONDS * IMPULSE_RATE) - 2;
+    if (impulses.count() < expected)
+    {
+        std::fprintf(stderr, "[FAIL] %llu impulses reached the screen, expected at least %llu\n",
+                     (unsigned long long)impulses.count(), (unsigned long long)expected);
+        return 1;
+    }
+    if (missed != 0)
+    {
+        std::fprintf(stderr, "[FAIL] %llu impulses never reached the screen\n", (unsigned long long)missed);
+        return 1;
+    }
+    if (!(impulses.percentile(0.99) <= MAX_P99_SECONDS))
+    {
+        std::fprintf(stderr, "[FAIL] impulse -> drawn p99 %.1f ms, bound %.0f ms\n", impulses.percentile(0.99) * 1e3,
+                     MAX_P99_SECONDS * 1e3);
+        return 1;
+    }
+    return 0;
+}
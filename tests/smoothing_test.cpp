@@ -0,0 +1,60 @@
+// Bars and spokes decay towards silence by repeated exponential smoothing.
+// Without the resting-level snap the decay walks down into denormal floats,
+// where every later step is many times slower; with it, a released level
+// lands exactly on zero and stays there, and rising levels are unaffected.
+#include <cmath>
+#include <cstdio>
+#include "visualizer/smoothing.hpp"
+
+namespace
+{
+    constexpr float DT = 1.0f / 60.0f;
+    constexpr float ATTACK_TAU = 0.03f;  // The views' defaults
+    constexpr float RELEASE_TAU = 0.12f;
+    constexpr int SILENT_FRAMES = 60 * 60;
+}
+
+int main()
+{
+    const float attack = 1.0f - std::exp(-DT / ATTACK_TAU);
+    const float release = 1.0f - std::exp(-DT / RELEASE_TAU);
+    int failures = 0;
+
+    // Full scale, then a minute of silence at 60 fps
+    float level = 1.0f;
+    int restFrame = -1;
+    for (int f = 0; f < SILENT_FRAMES; ++f)
+    {
+        level = smoothLevel(level, 0.0f, release);
+        if (level != 0.0f && std::fpclassify(level) != FP_NORMAL)
+        {
+            std::fprintf(stderr, "[FAIL] frame %d: level %g is denormal\n", f, level);
+            failures++;
+            break;
+        }
+        if (level == 0.0f && restFrame < 0)
+            restFrame = f;
+    }
+    std::printf("smoothing: released level reaches rest after %d frames\n", restFrame);
+    if (level != 0.0f)
+    {
+        std::fprintf(stderr, "[FAIL] level %g never reached rest\n", level);
+        failures++;
+    }
+
+    // Far above the snap, a step is plain exponential smoothing
+    float expected = 0.25f + (0.8f - 0.25f) * attack;
+    if (smoothLevel(0.25f, 0.8f, attack) != expected)
+    {
+        std::fprintf(stderr, "[FAIL] attack step changed by the snap\n");
+        failures++;
+    }
+
+    // A level at rest climbs again as soon as there is signal
+    if (!(smoothLevel(0.0f, 0.5f, attack) > 0.0f))
+    {
+        std::fprintf(stderr, "[FAIL] a resting level did not rise\n");
+        failures++;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,207 @@
+// Pixel checks for the CPU rasterizer: opaque and translucent fills (the
+// SSE2 span blend against a scalar reference of SFML's alpha blend), the
+// top-left rule on a shared edge, Wu line coverage and drawImage()'s
+// horizontal scroll wrap.
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "render/software_surface.hpp"
+
+namespace
+{
+    constexpr unsigned int WIDTH = 67; // Odd, so spans end in a scalar tail
+    constexpr unsigned int HEIGHT = 40;
+
+    int failures = 0;
+
+    void fail(const char *what, unsigned int x, unsigned int y, sf::Color got, sf::Color expected)
+    {
+        if (failures++ < 10)
+        {
+            std::fprintf(stderr, "[FAIL] %s at (%u, %u): got %u,%u,%u,%u expected %u,%u,%u,%u\n", what, x, y, got.r,
+                         got.g, got.b, got.a, expected.r, expected.g, expected.b, expected.a);
+        }
+    }
+
+    // Straight-alpha source-over, rounded to nearest, computed independently
+    sf::Color blendReference(sf::Color dst, sf::Color src)
+    {
+        auto channel = [&](unsigned int s, unsigned int d)
+        {
+            return (std::uint8_t)std::lround((s * src.a + d * (255.0 - src.a)) / 255.0);
+        };
+        return sf::Color(channel(src.r, dst.r), channel(src.g, dst.g), channel(src.b, dst.b), channel(255, dst.a));
+    }
+
+    // Every byte value shows up somewhere in the background
+    sf::Color background(unsigned int x, unsigned int y)
+    {
+        unsigned int i = y * WIDTH + x;
+        return sf::Color((std::uint8_t)(i * 7), (std::uint8_t)(i * 13 + 5), (std::uint8_t)(i * 29 + 11),
+                         (std::uint8_t)(i * 3 + 1));
+    }
+
+    sf::Vertex vertex(sf::Vector2f position, sf::Color color)
+    {
+        sf::Vertex v;
+        v.position = position;
+        v.color = color;
+        return v;
+    }
+
+    void paintBackground(SoftwareSurface &surface)
+    {
+        for (unsigned int y = 0; y < HEIGHT; ++y)
+        {
+            for (unsigned int x = 0; x < WIDTH; ++x)
+            {
+                sf::Vertex point = vertex({x + 0.5f, y + 0.5f}, background(x, y));
+                surface.drawVertices(&point, 1, sf::PrimitiveType::Points);
+            }
+        }
+    }
+
+    void drawQuad(SoftwareSurface &surface, float left, float top, float right, float bottom, sf::Color color)
+    {
+        const sf::Vertex quad[6] = {
+            vertex({left, top}, color), vertex({right, top}, color),    vertex({right, bottom}, color),
+            vertex({left, top}, color), vertex({right, bottom}, color), vertex({left, bottom}, color),
+        };
+        surface.drawVertices(quad, 6, sf::PrimitiveType::Triangles);
+    }
+
+    // A quad on whole pixel edges covers exactly its pixels, and each one is
+    // blended once over what was there
+    void checkQuad(std::uint8_t alpha)
+    {
+        SoftwareSurface surface(WIDTH, HEIGHT);
+        paintBackground(surface);
+        std::vector<sf::Color> before;
+        for (unsigned int y = 0; y < HEIGHT; ++y)
+            for (unsigned int x = 0; x < WIDTH; ++x)
+                before.push_back(surface.pixel(x, y));
+
+        const sf::Color color(200, 90, 17, alpha);
+        drawQuad(surface, 3.0f, 2.0f, 64.0f, 37.0f, color);
+
+        for (unsigned int y = 0; y < HEIGHT; ++y)
+        {
+            for (unsigned int x = 0; x < WIDTH; ++x)
+            {
+                bool inside = x >= 3 && x < 64 && y >= 2 && y < 37;
+                sf::Color dst = before[y * WIDTH + x];
+                sf::Color expected = inside ? blendReference(dst, color) : dst;
+                if (surface.pixel(x, y) != expected)
+                    fail(alpha == 255 ? "opaque quad" : "translucent quad", x, y, surface.pixel(x, y), expected);
+            }
+        }
+    }
+
+    // Two triangles share a diagonal that passes through pixel centers. With
+    // a translucent color, a pixel blended twice would come out brighter.
+    void checkSharedEdge()
+    {
+        SoftwareSurface surface(WIDTH, HEIGHT);
+        surface.clear(sf::Color(0, 0, 0, 255));
+        const sf::Color color(255, 255, 255, 128);
+        const sf::Vector2f a{4.5f, 3.5f}, b{60.5f, 3.5f}, c{60.5f, 31.5f}, d{4.5f, 31.5f};
+        const sf::Vertex triangles[6] = {vertex(a, color), vertex(b, color), vertex(c, color),
+                                         vertex(a, color), vertex(c, color), vertex(d, color)};
+        surface.drawVertices(triangles, 6, sf::PrimitiveType::Triangles);
+
+        const sf::Color once = blendReference(sf::Color(0, 0, 0, 255), color);
+        for (unsigned int y = 0; y < HEIGHT; ++y)
+        {
+            for (unsigned int x = 0; x < WIDTH; ++x)
+            {
+                // Centers on the top and left edges are in, on the bottom
+                // and right edges out: rows [3, 31), columns [4, 60)
+                bool inside = x >= 4 && x < 60 && y >= 3 && y < 31;
+                sf::Color expected = inside ? once : sf::Color(0, 0, 0, 255);
+                if (surface.pixel(x, y) != expected)
+                    fail("shared edge", x, y, surface.pixel(x, y), expected);
+            }
+        }
+    }
+
+    // A horizontal line on a pixel boundary splits its coverage between the
+    // rows on either side; on a pixel center it lands in one row
+    void checkLineCoverage()
+    {
+        SoftwareSurface surface(WIDTH, HEIGHT);
+        surface.clear(sf::Color(0, 0, 0, 255));
+        const sf::Vertex boundary[2] = {vertex({10.5f, 10.0f}, sf::Color::White), vertex({40.5f, 10.0f}, sf::Color::White)};
+        const sf::Vertex center[2] = {vertex({10.5f, 20.5f}, sf::Color::White), vertex({40.5f, 20.5f}, sf::Color::White)};
+        surface.drawVertices(boundary, 2, sf::PrimitiveType::Lines);
+        surface.drawVertices(center, 2, sf::PrimitiveType::Lines);
+
+        const sf::Color half = blendReference(sf::Color(0, 0, 0, 255), sf::Color(255, 255, 255, 128));
+        for (unsigned int x = 10; x <= 40; ++x)
+        {
+            if (surface.pixel(x, 9) != half)
+                fail("line on a boundary", x, 9, surface.pixel(x, 9), half);
+            if (surface.pixel(x, 10) != half)
+                fail("line on a boundary", x, 10, surface.pixel(x, 10), half);
+            if (surface.pixel(x, 20) != sf::Color::White)
+                fail("line on a center", x, 20, surface.pixel(x, 20), sf::Color::White);
+            if (surface.pixel(x, 21) != sf::Color(0, 0, 0, 255))
+                fail("line on a center", x, 21, surface.pixel(x, 21), sf::Color(0, 0, 0, 255));
+        }
+    }
+
+    // Destination column x shows source column (x + scrollX) mod width, for
+    // scroll offsets past either end
+    void checkImageScroll()
+    {
+        constexpr unsigned int IMAGE_WIDTH = 8;
+        SoftwareSurface surface(WIDTH, HEIGHT);
+        std::unique_ptr<SurfaceImage> image = surface.createImage({IMAGE_WIDTH, 1});
+        std::uint8_t pixels[IMAGE_WIDTH * 4];
+        for (unsigned int u = 0; u < IMAGE_WIDTH; ++u)
+        {
+            pixels[u * 4 + 0] = (std::uint8_t)(u * 30);
+            pixels[u * 4 + 1] = (std::uint8_t)(255 - u * 30);
+            pixels[u * 4 + 2] = (std::uint8_t)u;
+            pixels[u * 4 + 3] = 255;
+        }
+        image->update(pixels);
+
+        for (float scroll : {0.0f, 3.0f, 11.0f, -5.0f, 7.0f})
+        {
+            surface.clear(sf::Color(0, 0, 0, 255));
+            surface.drawImage(*image, sf::FloatRect({0.0f, 0.0f}, {(float)IMAGE_WIDTH, 4.0f}), scroll);
+
+            for (unsigned int x = 0; x < IMAGE_WIDTH; ++x)
+            {
+                int u = ((int)x + (int)scroll) % (int)IMAGE_WIDTH;
+                u = u < 0 ? u + IMAGE_WIDTH : u;
+                sf::Color expected(pixels[u * 4], pixels[u * 4 + 1], pixels[u * 4 + 2], 255);
+                for (unsigned int y = 0; y < 4; ++y)
+                {
+                    if (surface.pixel(x, y) != expected)
+                        fail("drawImage scroll", x, y, surface.pixel(x, y), expected);
+                }
+            }
+            if (surface.pixel(IMAGE_WIDTH, 0) != sf::Color(0, 0, 0, 255))
+                fail("drawImage past dest", IMAGE_WIDTH, 0, surface.pixel(IMAGE_WIDTH, 0), sf::Color(0, 0, 0, 255));
+        }
+    }
+}
+
+int main()
+{
+    for (int alpha : {255, 254, 128, 77, 1})
+        checkQuad((std::uint8_t)alpha);
+    checkSharedEdge();
+    checkLineCoverage();
+    checkImageScroll();
+
+    if (failures > 0)
+    {
+        std::fprintf(stderr, "[FAIL] %d pixels wrong\n", failures);
+        return 1;
+    }
+    std::printf("software surface: all pixels match\n");
+    return 0;
+}
@@ -0,0 +1,66 @@
+// Checks every magnitudeToDb() implementation this CPU can run against the
+// formula it replaced, 20 * log10(|X| + 1) / 60 computed in double, over
+// magnitudes from silence to far above full scale.
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "audio/spectrum_kernels.hpp"
+
+namespace
+{
+    constexpr float SCALE = 1.0f / 60.0f; // What FftProcessor passes
+    constexpr double MAX_ERROR_DB = 1e-4;
+    constexpr size_t BINS = 100003;        // Odd, so every kernel runs its tail too
+
+    double reference(const kiss_fft_cpx &bin)
+    {
+        double magnitude = std::sqrt((double)bin.r * bin.r + (double)bin.i * bin.i);
+        return 20.0 * std::log10(magnitude + 1.0) * SCALE;
+    }
+}
+
+int main()
+{
+    // Log-uniform magnitudes from 1e-6 to 1e5 at random phases, plus exact zeros
+    std::vector<kiss_fft_cpx> bins(BINS);
+    std::uint32_t state = 12345;
+    auto uniform = [&state]
+    {
+        state = state * 1664525u + 1013904223u;
+        return (state >> 8) / 16777216.0;
+    };
+    for (size_t i = 0; i < BINS; ++i)
+    {
+        double magnitude = i % 1000 == 0 ? 0.0 : std::pow(10.0, -6.0 + 11.0 * uniform());
+        double phase = 6.283185307179586 * uniform();
+        bins[i].r = (float)(magnitude * std::cos(phase));
+        bins[i].i = (float)(magnitude * std::sin(phase));
+    }
+
+    int failures = 0;
+    std::vector<float> out(BINS);
+    for (const MagnitudeToDbKernel &kernel : magnitudeToDbKernels())
+    {
+        kernel.fn(bins.data(), BINS, SCALE, out.data());
+
+        double worst = 0.0;
+        size_t bad = 0; // Out of bounds or NaN
+        for (size_t i = 0; i < BINS; ++i)
+        {
+            double error = std::fabs(out[i] - reference(bins[i])) / SCALE;
+            if (!(error <= MAX_ERROR_DB))
+                bad++;
+            else if (error > worst)
+                worst = error;
+        }
+
+        std::printf("%-6s max error %.2e dB\n", kernel.name, worst);
+        if (bad > 0)
+        {
+            std::fprintf(stderr, "[FAIL] %s misses the %.0e dB bound on %zu bins\n", kernel.name, MAX_ERROR_DB, bad);
+            failures++;
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
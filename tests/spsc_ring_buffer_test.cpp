@@ -0,0 +1,179 @@
+// Stress test for SpscRingBuffer: one producer and one consumer thread hammer
+// the ring with random chunk sizes. Every element is its own frame number, so
+// the consumer can tell exactly which frames were dropped and whether any was
+// overwritten, duplicated or reordered on the way.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "audio/spsc_ring_buffer.hpp"
+
+namespace
+{
+    constexpr std::uint32_t FRAMES = 1u << 20;
+    constexpr std::size_t MIN_CAPACITY = 1000; // Not a power of two on purpose
+    constexpr std::size_t MAX_CHUNK = 300;
+
+    // Small deterministic generator, one per thread
+    struct XorShift
+    {
+        std::uint32_t state;
+        std::uint32_t next()
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+        std::size_t chunk() { return 1 + next() % MAX_CHUNK; }
+    };
+
+    struct Result
+    {
+        std::uint64_t received = 0;
+        std::uint64_t gaps = 0;        // Frames missing between consecutive reads
+        std::uint64_t overwritten = 0; // Frames that came back out of order or twice
+    };
+
+    // Consumer: pops random-sized chunks until the producer is done and the
+    // ring is empty. `stallEvery` > 0 makes it sleep now and then, so the
+    // producer overruns it.
+    Result consume(SpscRingBuffer<std::uint32_t> &ring, const std::atomic<bool> &producing, unsigned int stallEvery)
+    {
+        Result result;
+        XorShift random{0x9E3779B9u};
+        std::vector<std::uint32_t> buffer(MAX_CHUNK);
+        std::uint64_t expected = 0;
+        unsigned int pops = 0;
+
+        while (true)
+        {
+            bool done = !producing.load(std::memory_order_acquire);
+            std::size_t popped = ring.pop(buffer.data(), random.chunk());
+            if (popped == 0 && done && ring.available() == 0)
+                break;
+
+            for (std::size_t i = 0; i < popped; ++i)
+            {
+                if (buffer[i] < expected)
+                {
+                    result.overwritten++;
+                    continue;
+                }
+                result.gaps += buffer[i] - expected;
+                expected = buffer[i] + 1ull;
+                result.received++;
+            }
+
+            if (stallEvery > 0 && ++pops % stallEvery == 0)
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        return result;
+    }
+
+    // Producer pushes frames like an audio callback and never waits; whatever
+    // doesn't fit is dropped. Every frame must either arrive once, in order,
+    // or be counted as dropped.
+    bool runLossy()
+    {
+        SpscRingBuffer<std::uint32_t> ring(MIN_CAPACITY);
+        std::atomic<bool> producing{true};
+        Result result;
+        std::thread consumer([&] { result = consume(ring, producing, 64); });
+
+        XorShift random{0x12345678u};
+        std::vector<std::uint32_t> chunk(MAX_CHUNK);
+        std::uint32_t frame = 0;
+        while (frame < FRAMES)
+        {
+            std::size_t count = std::min<std::size_t>(random.chunk(), FRAMES - frame);
+            for (std::size_t i = 0; i < count; ++i)
+                chunk[i] = frame + (std::uint32_t)i;
+            ring.push(chunk.data(), count);
+            frame += (std::uint32_t)count;
+        }
+        producing.store(false, std::memory_order_release);
+        consumer.join();
+
+        // Trailing drops leave no gap behind them; account for them here
+        const std::uint64_t missing = FRAMES - result.received;
+        std::printf("lossy:    %u frames, %llu received, %llu dropped, %llu overwritten\n", FRAMES,
+                    (unsigned long long)result.received, (unsigned long long)ring.dropped(),
+                    (unsigned long long)result.overwritten);
+
+        bool ok = true;
+        if (result.overwritten != 0)
+        {
+            std::fprintf(stderr, "[FAIL] %llu frames overwritten or reordered\n", (unsigned long long)result.overwritten);
+            ok = false;
+        }
+        if (missing != ring.dropped() || result.gaps > missing)
+        {
+            std::fprintf(stderr, "[FAIL] %llu frames missing but %llu counted as dropped\n",
+                         (unsigned long long)missing, (unsigned long long)ring.dropped());
+            ok = false;
+        }
+        if (ring.dropped() == 0)
+        {
+            std::fprintf(stderr, "[FAIL] the stalled consumer never made the producer drop\n");
+            ok = false;
+        }
+        return ok;
+    }
+
+    // Producer only pushes what writable() says fits, so nothing may drop and
+    // the consumer must see every frame exactly once.
+    bool runLossless()
+    {
+        SpscRingBuffer<std::uint32_t> ring(MIN_CAPACITY);
+        std::atomic<bool> producing{true};
+        Result result;
+        std::thread consumer([&] { result = consume(ring, producing, 0); });
+
+        XorShift random{0xCAFEF00Du};
+        std::vector<std::uint32_t> chunk(MAX_CHUNK);
+        std::uint32_t frame = 0;
+        while (frame < FRAMES)
+        {
+            std::size_t count = std::min({random.chunk(), ring.writable(), (std::size_t)(FRAMES - frame)});
+            if (count == 0)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            for (std::size_t i = 0; i < count; ++i)
+                chunk[i] = frame + (std::uint32_t)i;
+            frame += (std::uint32_t)ring.push(chunk.data(), count);
+        }
+        producing.store(false, std::memory_order_release);
+        consumer.join();
+
+        std::printf("lossless: %u frames, %llu received, %llu dropped, %llu overwritten\n", FRAMES,
+                    (unsigned long long)result.received, (unsigned long long)ring.dropped(),
+                    (unsigned long long)result.overwritten);
+
+        if (result.received != FRAMES || result.gaps != 0 || result.overwritten != 0 || ring.dropped() != 0)
+        {
+            std::fprintf(stderr, "[FAIL] lossless run lost or corrupted frames\n");
+            return false;
+        }
+        return true;
+    }
+}
+
+int main()
+{
+    SpscRingBuffer<std::uint32_t> sized(MIN_CAPACITY);
+    if (sized.capacity() != 1024)
+    {
+        std::fprintf(stderr, "[FAIL] capacity %zu, expected 1024\n", sized.capacity());
+        return 1;
+    }
+
+    bool ok = runLossy();
+    ok = runLossless() && ok;
+    return ok ? 0 : 1;
+}
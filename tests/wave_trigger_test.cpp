@@ -0,0 +1,135 @@
+// The waveform trigger on a noisy sine: every edge findLastRisingEdge()
+// returns must sit on the sine's rising zero crossing (noise near zero must
+// not retrigger it), and fillWaveform() must show the same phase on every
+// frame however the frame boundaries fall.
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "audio/analysis_products.hpp"
+#include "audio/wave_trigger.hpp"
+
+namespace
+{
+    constexpr double PI = 3.14159265358979323846;
+    constexpr unsigned int SAMPLE_RATE = 44100;
+    constexpr double FREQUENCY = 220.7; // Period of ~199.8 samples, not a whole number
+    constexpr float AMPLITUDE = 0.5f;
+    constexpr float NOISE = 0.015f;     // Peak; below the analysis hysteresis of 0.02
+    constexpr float HYSTERESIS = 0.02f;
+    constexpr size_t SAMPLES = 1 << 16;
+
+    // Noise near a crossing moves it by about NOISE / slope, ~1 sample here
+    constexpr double MAX_EDGE_ERROR = 3.0;    // Samples
+    constexpr float MAX_ENVELOPE_DRIFT = 0.1f; // An unlocked frame differs by up to 2 * AMPLITUDE
+
+    std::vector<float> noisySine()
+    {
+        std::vector<float> samples(SAMPLES);
+        std::uint32_t state = 2024;
+        for (size_t n = 0; n < SAMPLES; ++n)
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            float noise = ((state >> 8) / 8388608.0f - 1.0f) * NOISE;
+            samples[n] = AMPLITUDE * (float)std::sin(2.0 * PI * FREQUENCY * n / SAMPLE_RATE) + noise;
+        }
+        return samples;
+    }
+
+    // Distance in samples from n to the nearest rising zero crossing of the clean sine
+    double distanceToCrossing(double n)
+    {
+        const double period = SAMPLE_RATE / FREQUENCY;
+        double cycles = n / period;
+        double offset = cycles - std::round(cycles);
+        return std::fabs(offset * period);
+    }
+
+    bool checkEdges(const std::vector<float> &samples)
+    {
+        const double period = SAMPLE_RATE / FREQUENCY;
+        const size_t search = 2000;
+        int failures = 0;
+        double worst = 0.0;
+        for (size_t offset = 0; offset + search <= SAMPLES; offset += 997)
+        {
+            long edge = findLastRisingEdge(samples.data() + offset, search, HYSTERESIS);
+            if (edge < 0)
+            {
+                std::fprintf(stderr, "[FAIL] no edge in the window at %zu\n", offset);
+                failures++;
+                continue;
+            }
+
+            double error = distanceToCrossing((double)(offset + edge));
+            worst = std::max(worst, error);
+            // It must also be the last crossing in the window
+            if (error > MAX_EDGE_ERROR || search - edge > period + MAX_EDGE_ERROR)
+            {
+                std::fprintf(stderr, "[FAIL] window at %zu: edge at %ld is %.1f samples off a rising crossing\n",
+                             offset, edge, error);
+                failures++;
+            }
+        }
+        std::printf("edges: worst %.2f samples from the rising crossing\n", worst);
+        return failures == 0;
+    }
+
+    bool checkLock(const std::vector<float> &samples)
+    {
+        AudioHistory history(SAMPLES);
+        history.append(samples.data(), samples.size());
+
+        AnalysisRequirements requirements;
+        requirements.products = ANALYSIS_WAVEFORM;
+        requirements.waveformColumns = 256;
+        requirements.waveformSeconds = 0.02f;
+        requirements.waveformTrigger = true;
+
+        // 60 fps worth of samples between frames, which is no multiple of the period
+        std::vector<float> firstMin, firstMax;
+        float worst = 0.0f;
+        int failures = 0;
+        for (uint64_t sequence = 20000; sequence < SAMPLES; sequence += SAMPLE_RATE / 60)
+        {
+            AnalysisFrame frame;
+            frame.sequence = sequence;
+            fillWaveform(history, SAMPLE_RATE, requirements, frame);
+            if (!frame.waveTriggered)
+            {
+                std::fprintf(stderr, "[FAIL] frame at %llu found no trigger\n", (unsigned long long)sequence);
+                failures++;
+                continue;
+            }
+            if (firstMin.empty())
+            {
+                firstMin = frame.waveMin;
+                firstMax = frame.waveMax;
+                continue;
+            }
+            for (size_t c = 0; c < firstMin.size(); ++c)
+            {
+                worst = std::max({worst, std::fabs(frame.waveMin[c] - firstMin[c]), std::fabs(frame.waveMax[c] - firstMax[c])});
+            }
+        }
+
+        std::printf("lock: envelopes drift at most %.3f between frames\n", worst);
+        if (worst > MAX_ENVELOPE_DRIFT)
+        {
+            std::fprintf(stderr, "[FAIL] triggered envelope drifts by %.3f, bound %.2f\n", worst, MAX_ENVELOPE_DRIFT);
+            failures++;
+        }
+        return failures == 0;
+    }
+}
+
+int main()
+{
+    std::vector<float> samples = noisySine();
+    bool ok = checkEdges(samples);
+    ok = checkLock(samples) && ok;
+    return ok ? 0 : 1;
+}